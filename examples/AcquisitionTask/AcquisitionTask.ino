@@ -0,0 +1,52 @@
+// This Example shows how to share an ADS1115 between FreeRTOS tasks on an ESP32
+// The acquisition task owns the bus and the device, the other tasks only read the latest samples (they never block)
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+#include <AdsAcquisitionTask.h>
+
+/// The ADS instance used to read (only used by the acquisition task once it has started)
+Ads1115Plus ads;
+
+/// Reads channel 0 and 1 of [ads]
+AdsScanner scanner(ads);
+
+/// The latest sample of each channel
+AdsSampleBoard board;
+
+/// Polls [scanner] in its own task and publishes the samples to [board]
+AdsAcquisitionTask acquisition(board);
+
+/// A task reading the latest value of channel 1
+void printerTask(void *parameters) {
+    while (true) {
+        AdsSample sample;
+        if (board.read(AdsAddress::gnd, MuxConfig::channel1, sample)) {
+            Serial.print("[printer] channel 1 = "); Serial.println(sample.raw);
+        }
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    ads.begin(); // Start I2C communication
+
+    scanner.addSlot(MuxConfig::channel0);
+    scanner.addSlot(MuxConfig::channel1);
+    scanner.start(5000); // A few ticks, the task sleeps between the polls
+
+    // Pinned to core 0 with priority 2 (loop() runs on core 1 with priority 1)
+    acquisition.addScanner(scanner);
+    acquisition.begin(4096, 2, 0);
+
+    xTaskCreate(printerTask, "printer", 2048, nullptr, 1, nullptr);
+}
+
+void loop() {
+    AdsSample sample;
+    if (board.read(AdsAddress::gnd, MuxConfig::channel0, sample)) {
+        Serial.print("[loop] channel 0 = "); Serial.print(sample.raw);
+        Serial.print(" (samples published: "); Serial.print(acquisition.getPublishedSamples()); Serial.println(")");
+    }
+    delay(1000);
+}
@@ -0,0 +1,42 @@
+// This Example shows how to log the four channels as binary sample records instead of text
+// The channels are read in turn at 860 SPS, one conversion every 1.63ms (the conversion plus the i2c transfers at
+// 400kHz): about 610 samples per second in total, roughly 150 per channel. The ADS1115 converts a single input at a
+// time, so 860 SPS is the total for all the channels. Each sample takes 7 bytes, about 4.3kB per second, which fits a
+// 115200 baud link
+// Decode the stream on the receiving side with AdsRecordDecoder
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+#include <AdsSampleRecord.h>
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Reads the four channels in turn
+AdsScanner scanner(ads);
+
+/// Encodes the samples into binary records
+AdsRecordEncoder encoder;
+
+/// Writes each sample to Serial
+void logSample(const AdsSample &sample, void *) {
+    encoder.write(Serial, sample);
+}
+
+void setup() {
+    Serial.begin(115200);
+    ads.begin(); // Start I2C communication
+    Wire.setClock(400000);
+
+    scanner.addSlot(MuxConfig::channel0, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.addSlot(MuxConfig::channel2, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.addSlot(MuxConfig::channel3, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.setSampleCallback(logSample);
+
+    // The conversion time plus the time of the i2c transfers of each conversion
+    scanner.start(scanner.minimumPeriodMicros() + 300);
+}
+
+void loop() {
+    scanner.poll();
+}
@@ -0,0 +1,40 @@
+// This Example shows how to configure several ADS1115 in a single pass at startup
+// Board 0x48 watches channel 0 with a window comparator, board 0x49 converts channel 1 continuously
+// Only the registers that differ from the reset values are written, then every register is read back to verify it
+#include <Ads1115Plus.h>
+#include <AdsBulkConfig.h>
+
+/// The board with the comparator (ADR pin to GND)
+Ads1115Plus comparatorAds(AdsAddress::gnd, AdsGain::one, AdsSampleSpeed::sps128);
+
+/// The board converting continuously (ADR pin to VCC)
+Ads1115Plus continuousAds(AdsAddress::vcc, AdsGain::two, AdsSampleSpeed::sps860);
+
+/// The configuration of both boards
+AdsBulkConfig config;
+
+void setup() {
+    Serial.begin(9600);
+    Wire.begin(); // Start I2C communication
+
+    AdsDeviceSetup *window = config.addComparator(comparatorAds, MuxConfig::channel0, 24000, 8000); // 3.0v and 1.0v at gain one
+    window->comparatorMode = ComparatorModeConfig::windowComparator;
+    window->comparatorQueue = ComparatorAssertConfig::assertAfterTwo;
+    config.add(continuousAds, AdsDeviceMode::continuous, MuxConfig::channel1);
+
+    unsigned long start = micros();
+    AdsBulkResult result = config.apply();
+    unsigned long elapsed = micros() - start;
+
+    Serial.print("Registers written: "); Serial.print(result.registersWritten);
+    Serial.print(", skipped: "); Serial.print(result.registersSkipped);
+    Serial.print(", took "); Serial.print(elapsed); Serial.println("us");
+    if (!result.succeeded()) {
+        Serial.print("Failed devices (bit mask): "); Serial.println(result.failedDevices, BIN);
+    }
+}
+
+void loop() {
+    Serial.print("Channel 1 millivolts = "); Serial.println(continuousAds.getLastConversionMillivolts());
+    delay(500);
+}
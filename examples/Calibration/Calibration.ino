@@ -0,0 +1,56 @@
+// This Example shows how to measure the offset of a differential input and store the calibration in EEPROM
+// Short A0 and A1 and send 'c' through the serial monitor to calibrate, the corrected microvolts are printed every second
+#include <Ads1115Plus.h>
+#include <AdsCalibration.h>
+#include <EEPROM.h>
+
+/// The EEPROM address where the calibration image is stored
+const int eepromAddress = 0;
+
+/// The ADS instance used to read
+Ads1115Plus ads(AdsAddress::gnd, AdsGain::sixteen);
+
+/// The correction tables of [ads]
+AdsCalibration calibration;
+
+/// Loads the calibration image from EEPROM (the tables are left uncorrected if the image isn't valid)
+void loadCalibration() {
+    uint8_t image[ADS_CALIBRATION_IMAGE_SIZE];
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = EEPROM.read(eepromAddress + i);
+    }
+    Serial.println(calibration.readImage(image, sizeof(image)) ? "Calibration loaded" : "No calibration found");
+}
+
+/// Stores the calibration image in EEPROM
+void storeCalibration() {
+    uint8_t image[ADS_CALIBRATION_IMAGE_SIZE];
+    size_t length = calibration.writeImage(image, sizeof(image));
+    for (size_t i = 0; i < length; i++) {
+        EEPROM.update(eepromAddress + i, image[i]);
+    }
+}
+
+void setup() {
+    Serial.begin(9600);
+    ads.begin(); // Start I2C communication
+
+    loadCalibration();
+    ads.setCalibration(&calibration);
+}
+
+void loop() {
+
+    // Measure the offset with the inputs shorted
+    if (Serial.available() && Serial.read() == 'c') {
+        int16_t offset = calibration.measureOffset(ads, MuxConfig::differential01, ads.getGain());
+        storeCalibration();
+        Serial.print("Offset = "); Serial.println(offset);
+    }
+
+    // Read the corrected value (integer math only)
+    int32_t microvolts = ads.readMicrovoltsOnMux(MuxConfig::differential01);
+    Serial.print("A0 - A1 = "); Serial.print(microvolts); Serial.println("uV");
+
+    delay(1000);
+}
@@ -0,0 +1,83 @@
+// This Example shows how to keep the min / max / mean / RMS of channels 0 and 1 while they are sampled
+// The statistics are printed every second, the window restarts without stopping the scanner.
+// The setup also compares the time per sample with the same statistics computed with doubles
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+#include <AdsChannelStats.h>
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Reads channel 0 and 1 of [ads]
+AdsScanner scanner(ads);
+
+/// The statistics of channel 0 and 1
+AdsChannelStats stats[2];
+
+/// The start of the current window
+unsigned long windowStart = 0;
+
+/// Adds each sample to the statistics of its channel
+void addSample(const AdsSample &sample, void *) {
+    stats[sample.mux == MuxConfig::channel0 ? 0 : 1].add(sample);
+}
+
+/// Prints the time per sample of AdsChannelStats and of the same statistics with doubles
+void benchmark() {
+    const int samples = 1000;
+    AdsChannelStats integerStats;
+    unsigned long start = micros();
+    for (int i = 0; i < samples; i++) {
+        integerStats.add((int16_t)((long)i * 37 % 30000), AdsGain::one);
+    }
+    unsigned long integerMicros = micros() - start;
+
+    volatile double sum = 0, sumSquared = 0, minimum = 1e9, maximum = -1e9;
+    start = micros();
+    for (int i = 0; i < samples; i++) {
+        double value = ads.rawValueToMillivolts((int16_t)((long)i * 37 % 30000));
+        sum += value;
+        sumSquared += value * value;
+        if (value < minimum) minimum = value;
+        if (value > maximum) maximum = value;
+    }
+    unsigned long doubleMicros = micros() - start;
+
+    Serial.print("Integer statistics: "); Serial.print(integerMicros / (float)samples); Serial.println("us per sample");
+    Serial.print("Double statistics: "); Serial.print(doubleMicros / (float)samples); Serial.println("us per sample");
+}
+
+void printStats(int channel) {
+    AdsStatsSnapshot snapshot;
+    stats[channel].snapshot(snapshot);
+
+    Serial.print("Channel "); Serial.print(channel);
+    Serial.print(": "); Serial.print(snapshot.count); Serial.print(" samples");
+    Serial.print(" min "); Serial.print(snapshot.minMicrovolts);
+    Serial.print(" max "); Serial.print(snapshot.maxMicrovolts);
+    Serial.print(" mean "); Serial.print(snapshot.meanMicrovolts);
+    Serial.print(" rms "); Serial.print(snapshot.rmsMicrovolts);
+    Serial.print(" stddev "); Serial.print(snapshot.stddevMicrovolts); Serial.println("uV");
+}
+
+void setup() {
+    Serial.begin(9600);
+    ads.begin(); // Start I2C communication
+    benchmark();
+
+    scanner.addSlot(MuxConfig::channel0, AdsGain::one);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::four);
+    scanner.setSampleCallback(addSample);
+    scanner.start(10000);
+    windowStart = millis();
+}
+
+void loop() {
+    scanner.poll();
+
+    if (millis() - windowStart >= 1000) {
+        windowStart += 1000;
+        printStats(0);
+        printStats(1);
+    }
+}
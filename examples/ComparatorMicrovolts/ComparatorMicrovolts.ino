@@ -0,0 +1,39 @@
+// This Example shows how to set the comparator thresholds in microvolts
+// The gain is switched every few seconds, the thresholds keep their voltage (the raw registers are recomputed and
+// only the ones that change are written)
+#include <Ads1115Plus.h>
+
+/// The pin used to detect the alrt interrupt
+const int alrtPin = 2;
+
+/// The threshold above which the comparator will assert
+const int32_t highThresholdMicrovolts = 1875000; // 1.875 V
+
+/// The threshold below which the comparator will de-assert
+const int32_t lowThresholdMicrovolts = 1687500; // 1.6875 V
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Whether the narrow range (gain one, +/- 4.096V) is used
+bool narrowRange = false;
+
+void setup() {
+    Serial.begin(9600);
+    pinMode(alrtPin, INPUT);
+
+    ads.begin();
+    ads.startComparatorModeMicrovolts(MuxConfig::channel0, highThresholdMicrovolts, lowThresholdMicrovolts);
+}
+
+void loop() {
+    Serial.print("Channel 0: "); Serial.print(ads.getLastConversionMicrovolts()); Serial.print("uV");
+    Serial.print(" ; ALRT/RDY: "); Serial.println(digitalRead(alrtPin) == HIGH ? "High" : "Low");
+
+    // Switch the range, the thresholds follow
+    narrowRange = !narrowRange;
+    ads.setGain(narrowRange ? AdsGain::one : AdsGain::twoThirds);
+    Serial.print("Gain switched, raw high threshold is now "); Serial.println(ads.microvoltsToRawValue(highThresholdMicrovolts));
+
+    delay(2000);
+}
@@ -0,0 +1,64 @@
+// This Example measures the compression ratio and the encoding cost of AdsDeltaEncoder
+// Two signals are compressed: a simulated slow signal with a few LSB of noise and a recording of channel 0
+#include <Ads1115Plus.h>
+#include <AdsDeltaCompressor.h>
+
+/// The number of samples in each benchmark
+const int sampleCount = 256;
+
+/// The channel of the ADS used for the recording
+const int adsChannel = 0;
+
+/// The ADS instance used to read
+Ads1115Plus ads(AdsAddress::gnd, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+
+/// The samples being compressed
+int16_t values[sampleCount];
+
+/// The compressed samples
+uint8_t compressed[sampleCount * ADS_DELTA_MAX_BYTES_PER_VALUE];
+
+/// Compresses [values] and prints the compression ratio and the cpu cycles per sample
+void runBenchmark(const char *name) {
+    AdsDeltaEncoder encoder;
+    size_t encodedCount;
+
+    unsigned long start = micros();
+    size_t length = encoder.encodeBlock(adsChannel, values, sampleCount, compressed, sizeof(compressed), encodedCount);
+    unsigned long elapsed = micros() - start;
+
+    // Check the values are recovered
+    AdsDeltaDecoder decoder;
+    int16_t decoded;
+    size_t position = 0;
+    bool matches = true;
+    for (int i = 0; i < sampleCount; i++) {
+        position += decoder.decode(adsChannel, compressed + position, length - position, decoded);
+        matches = matches && decoded == values[i];
+    }
+
+    Serial.print(name); Serial.print(": "); Serial.print(sampleCount * 2); Serial.print(" -> "); Serial.print(length);
+    Serial.print(" bytes, ratio = "); Serial.print((double)sampleCount * 2 / length);
+    Serial.print(", cycles / sample = "); Serial.print(elapsed * (F_CPU / 1000000UL) / sampleCount);
+    Serial.println(matches ? "" : " (decoding mismatch!)");
+}
+
+void setup() {
+    Serial.begin(115200);
+    ads.begin(); // Start I2C communication
+
+    // Simulated signal: a slow ramp with +/- 2 LSB of noise
+    for (int i = 0; i < sampleCount; i++) {
+        values[i] = 12000 + i * 3 + random(-2, 3);
+    }
+    runBenchmark("Simulated");
+
+    // Recorded signal
+    for (int i = 0; i < sampleCount; i++) {
+        values[i] = ads.readRawOnMux(MuxConfig::channel0);
+    }
+    runBenchmark("Recorded");
+}
+
+void loop() {
+}
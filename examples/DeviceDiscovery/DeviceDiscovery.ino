@@ -0,0 +1,41 @@
+// This Example shows how to discover the ADS1115 connected to the i2c bus and detect boards being added or removed
+// Channel 0 of every board found is read, while one address is re-probed on each loop
+#include <AdsDeviceScanner.h>
+
+/// The channel of the ADS used for reading
+const int adsChannel = 0;
+
+/// Keeps track of the ADS1115 on the bus (0x48 to 0x4B)
+AdsDeviceScanner scanner;
+
+void setup() {
+    Serial.begin(9600);
+    Wire.begin(); // Start I2C communication
+
+    // Reset the boards so the ones configured by a previous run are found as well
+    byte found = scanner.scan(true);
+    Serial.print("Found "); Serial.print(found); Serial.println(" ADS1115");
+}
+
+void loop() {
+
+    // Read the boards that are present
+    const AdsAddress addresses[] = { AdsAddress::gnd, AdsAddress::vcc, AdsAddress::sda, AdsAddress::scl };
+    for (AdsAddress address : addresses) {
+        Ads1115Plus *ads = scanner.device(address);
+        if (ads == nullptr) {
+            continue;
+        }
+        Serial.print("0x"); Serial.print((byte)address, HEX); Serial.print(" channel "); Serial.print(adsChannel);
+        Serial.print(" millivolts = "); Serial.println(ads->readChannelMillivolts(adsChannel));
+    }
+
+    // Probe a single address, this costs a single i2c transaction
+    AdsPresenceChange change = scanner.probeNext();
+    if (change != AdsPresenceChange::none) {
+        Serial.print("0x"); Serial.print((byte)scanner.lastChangedAddress(), HEX);
+        Serial.println(change == AdsPresenceChange::added ? " added" : " removed");
+    }
+
+    delay(1000);
+}
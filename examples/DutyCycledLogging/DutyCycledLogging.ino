@@ -0,0 +1,45 @@
+// This Example shows how to log slowly with the ADS1115 powered down between the conversions
+// Channels 0 and 1 are read every 10 seconds at 860 SPS (the shortest time converting), the board can sleep in between
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+#include <AdsDutyCycleLogger.h>
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Reads channel 0 and 1 of [ads]
+AdsScanner scanner(ads);
+
+/// Schedules the conversions of [scanner]
+AdsDutyCycleLogger logger(scanner);
+
+/// Prints each sample logged
+void printSample(const AdsSample &sample, void *) {
+    Serial.print(sample.timestampMicros); Serial.print("us channel ");
+    Serial.print(sample.mux == MuxConfig::channel0 ? 0 : 1); Serial.print(": ");
+    Serial.print(ads.rawValueToMicrovolts(sample.raw, sample.mux, sample.gain)); Serial.println("uV");
+}
+
+void setup() {
+    Serial.begin(9600);
+    ads.begin(); // Start I2C communication
+
+    scanner.addSlot(MuxConfig::channel0, AdsGain::one);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::one);
+    scanner.setSampleCallback(printSample);
+    logger.start(10000000);
+
+    AdsEnergyEstimate estimate = logger.estimate();
+    Serial.print("Estimated ADS1115 charge per sample: "); Serial.print(estimate.chargePerSampleNanocoulombs); Serial.println("nC");
+    Serial.print("Estimated ADS1115 average current: "); Serial.print(estimate.averageCurrentNanoamps); Serial.println("nA");
+}
+
+void loop() {
+    logger.poll();
+
+    // Replace with the sleep mode of the board (keeping micros() running, or adding the time slept)
+    uint32_t sleep = logger.sleepMicros();
+    if (sleep > 2000) {
+        delay((sleep - 1000) / 1000);
+    }
+}
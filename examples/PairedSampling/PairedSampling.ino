@@ -0,0 +1,54 @@
+// This Example shows how to measure the power of a load from a current shunt and a voltage divider
+// The shunt is on differential 0-1 and the divider on channel 2. Both are read alternately at 860 SPS and the shunt
+// is interpolated to the time of each voltage conversion, so the products use both values at the same instant
+#include <Ads1115Plus.h>
+#include <AdsPairedSampler.h>
+
+/// The shunt resistance in ohms
+const double shuntOhms = 0.1;
+
+/// The divider ratio (input voltage / voltage on channel 2)
+const double dividerRatio = 11.0;
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Reads the divider (reference) and the shunt
+AdsPairedSampler sampler(ads);
+
+/// The sum of the instantaneous powers (W) and the number of pairs added
+double powerSum = 0;
+uint32_t powerCount = 0;
+
+/// The start of the current second
+unsigned long windowStart = 0;
+
+/// Adds the power of each pair
+void addPair(const AdsSamplePair &pair, void *) {
+    double volts = ads.rawValueToMicrovolts(pair.referenceRaw, MuxConfig::channel2, AdsGain::one) * dividerRatio / 1e6;
+    double amps = ads.rawValueToMicrovolts(pair.otherRaw, MuxConfig::differential01, AdsGain::sixteen) / shuntOhms / 1e6;
+    powerSum += volts * amps;
+    powerCount++;
+}
+
+void setup() {
+    Serial.begin(9600);
+    ads.begin(); // Start I2C communication
+
+    sampler.setInputs(MuxConfig::channel2, AdsGain::one, MuxConfig::differential01, AdsGain::sixteen);
+    sampler.setPairCallback(addPair);
+    sampler.start();
+    windowStart = millis();
+}
+
+void loop() {
+    sampler.poll();
+
+    if (millis() - windowStart >= 1000) {
+        windowStart += 1000;
+        Serial.print("Mean power: "); Serial.print(powerCount > 0 ? powerSum / powerCount : 0, 4);
+        Serial.print("W over "); Serial.print(powerCount); Serial.println(" pairs");
+        powerSum = 0;
+        powerCount = 0;
+    }
+}
@@ -0,0 +1,46 @@
+// This Example shows how to read two channels at evenly spaced times and measure the timing quality
+// Channel 0 and 1 are read alternately every 2ms (each channel is read every 4ms, 250 samples per second)
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+
+/// The time between two conversions (in microseconds)
+const unsigned long periodMicros = 2000;
+
+/// The ADS instance used to read
+Ads1115Plus ads;
+
+/// Reads the scan list of [ads] at evenly spaced times
+AdsScanner scanner(ads);
+
+/// The last value read on each channel
+volatile int16_t lastValues[2];
+
+/// Called by the scanner with each sample
+void onSample(const AdsSample &sample, void *) {
+    lastValues[sample.mux == MuxConfig::channel0 ? 0 : 1] = sample.raw;
+}
+
+void setup() {
+    Serial.begin(115200);
+    ads.begin(); // Start I2C communication
+
+    scanner.addSlot(MuxConfig::channel0, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+    scanner.setSampleCallback(onSample);
+    scanner.start(periodMicros);
+}
+
+void loop() {
+    scanner.poll();
+
+    // Print the timing quality every second (printing adds jitter to the next conversion)
+    static unsigned long lastPrint = 0;
+    if (millis() - lastPrint >= 1000) {
+        lastPrint = millis();
+        AdsJitterStats stats = scanner.getJitterStats();
+        Serial.print("ch0 = "); Serial.print(lastValues[0]); Serial.print(", ch1 = "); Serial.print(lastValues[1]);
+        Serial.print(" | jitter min = "); Serial.print(stats.minMicros); Serial.print("us, max = "); Serial.print(stats.maxMicros);
+        Serial.print("us, stddev = "); Serial.print(stats.stddevMicros()); Serial.print("us, overruns = "); Serial.println(stats.overruns);
+        scanner.resetJitterStats();
+    }
+}
@@ -0,0 +1,41 @@
+// This Example shows how to pick the sample speed of each channel from its measured noise
+// Keep the inputs steady while the noise is measured (about 4.5s per channel)
+#include <Ads1115Plus.h>
+#include <AdsScanner.h>
+#include <AdsRateOptimizer.h>
+
+/// The noise allowed on each channel (in nanovolts)
+const uint32_t targetNoiseNanovolts = 100000; // 100uV
+
+/// The ADS instance used to read
+Ads1115Plus ads;
+
+/// Reads the scan list of [ads]
+AdsScanner scanner(ads);
+
+/// Picks the sample speed of each slot of [scanner]
+AdsRateOptimizer optimizer(scanner);
+
+void setup() {
+    Serial.begin(115200);
+    ads.begin(); // Start I2C communication
+
+    scanner.addSlot(MuxConfig::channel0, AdsGain::twoThirds);
+    scanner.addSlot(MuxConfig::differential23, AdsGain::sixteen);
+
+    optimizer.characterize();
+    bool meetsTarget = optimizer.selectForNoise(targetNoiseNanovolts);
+
+    for (byte i = 0; i < scanner.getSlotCount(); i++) {
+        AdsScanSlot &slot = scanner.slot(i);
+        Serial.print("Slot "); Serial.print(i); Serial.print(": "); Serial.print(optimizer.noiseMicrovolts(i, slot.speed));
+        Serial.print("uV noise, "); Serial.print(Ads1115Plus::conversionTimeMicros(slot.speed)); Serial.println("us conversion");
+    }
+    Serial.println(meetsTarget ? "Every slot meets the target" : "Some slots can't meet the target");
+
+    scanner.start(scanner.minimumPeriodMicros() + 500);
+}
+
+void loop() {
+    scanner.poll();
+}
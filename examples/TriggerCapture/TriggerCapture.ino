@@ -0,0 +1,57 @@
+// This Example shows how to capture the waveform around a comparator event, like the trigger of an oscilloscope
+// The ALRT pin interrupt only requests the trigger, the conversions are read in loop() at the data rate
+// 100 samples before and 100 samples after the event are kept (400 bytes, supplied here so no heap is used)
+#include <Ads1115Plus.h>
+#include <AdsTriggerCapture.h>
+
+/// The pin used to detect the alrt interrupt
+const int alrtPin = 2;
+
+/// The number of samples kept before the event
+const uint16_t preTriggerSamples = 100;
+
+/// The number of samples kept from the event on
+const uint16_t postTriggerSamples = 100;
+
+/// The reference to the ADS object
+Ads1115Plus ads(AdsAddress::gnd, AdsGain::twoThirds, AdsSampleSpeed::sps860);
+
+/// The captured samples
+int16_t captureBuffer[preTriggerSamples + postTriggerSamples];
+
+/// Keeps the history and freezes the window around the event
+AdsTriggerCapture capture(ads, captureBuffer, preTriggerSamples + postTriggerSamples);
+
+/// Interrupt routine called when the comparator asserts (O(1), only sets a flag)
+void alertPinAsserted() {
+    capture.trigger();
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    pinMode(alrtPin, INPUT);
+    attachInterrupt(digitalPinToInterrupt(alrtPin), alertPinAsserted, FALLING);
+
+    ads.begin();
+    ads.startComparatorModeMicrovolts(MuxConfig::channel0, 1875000, 1687500);
+    capture.arm(preTriggerSamples, postTriggerSamples);
+}
+
+void loop() {
+    capture.poll();
+    if (!capture.isComplete()) {
+        return;
+    }
+
+    Serial.print("Triggered at "); Serial.print(capture.getTriggerMicros());
+    Serial.print("us, one sample every "); Serial.print(capture.getSamplePeriodMicros()); Serial.println("us");
+    for (uint16_t i = 0; i < capture.getSampleCount(); i++) {
+        Serial.print((int)i - (int)capture.getPreTriggerSamples()); Serial.print(": ");
+        Serial.print(capture.sampleMicrovolts(i)); Serial.println("uV");
+    }
+
+    // Clear the latch (if any) and wait for the next event
+    ads.clearComparatorLatch();
+    capture.arm(preTriggerSamples, postTriggerSamples);
+}
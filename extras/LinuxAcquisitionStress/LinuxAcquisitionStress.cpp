@@ -0,0 +1,179 @@
+// This program stresses the sample board shared between the acquisition thread and the readers
+// 1. A writer thread publishes as fast as it can while reader threads check every sample they copy is whole
+//    (the raw value and gain are derived from the timestamp, a torn read breaks the relation)
+// 2. The acquisition thread scans two simulated devices while reader threads check the channels, sequences and times
+// Exits with 1 if a check fails. Build with -fsanitize=thread as well to let ThreadSanitizer check the accesses
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxAcquisitionStress/LinuxAcquisitionStress.cpp -o acquisition_stress -lpthread
+#include <Ads1115Plus.h>
+#include <AdsAcquisitionTask.h>
+#include <AdsScanner.h>
+#include <AdsSimulator.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/// The number of reader threads
+const int readerCount = 4;
+
+/// The number of samples published by the writer of the first test
+const uint32_t publishCount = 2000000;
+
+/// The time the acquisition of the second test runs
+const unsigned long acquisitionMicros = 2000000;
+
+/// The number of failed checks
+std::atomic<int> failures(0);
+
+/// Prints [message] and counts a failure when [condition] is false
+void check(bool condition, const char *message) {
+    if (!condition) {
+        printf("  FAIL: %s\n", message);
+        failures++;
+    }
+}
+
+/// The raw value published with [timestamp] in the first test
+int16_t rawOf(uint32_t timestamp) {
+    return (int16_t)(timestamp * 7919);
+}
+
+/// The gain published with [timestamp] in the first test
+AdsGain gainOf(uint32_t timestamp) {
+    return (AdsGain)((uint16_t)(timestamp % ADS_GAIN_COUNT) << 9);
+}
+
+/// Publishes [publishCount] samples on two channels while the readers copy them
+void tornReadTest() {
+    AdsSampleBoard board;
+    std::atomic<bool> writing(true);
+    std::atomic<uint32_t> copies(0), tornCopies(0), emptyReads(0);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readerCount; i++) {
+        readers.emplace_back([&, i]() {
+            MuxConfig mux = i % 2 == 0 ? MuxConfig::channel0 : MuxConfig::differential23;
+            uint32_t lastTimestamp = 0;
+            while (writing.load(std::memory_order_relaxed)) {
+                AdsSample sample;
+                if (!board.read(1, mux, sample)) {
+                    emptyReads++;
+                    continue;
+                }
+                copies++;
+                if (sample.raw != rawOf(sample.timestampMicros) || sample.gain != gainOf(sample.timestampMicros)
+                    || sample.device != 1 || sample.mux != mux || sample.timestampMicros < lastTimestamp) {
+                    tornCopies++;
+                }
+                lastTimestamp = sample.timestampMicros;
+            }
+        });
+    }
+
+    for (uint32_t timestamp = 1; timestamp <= publishCount; timestamp++) {
+        AdsSample sample;
+        sample.device = 1;
+        sample.mux = timestamp % 2 == 0 ? MuxConfig::channel0 : MuxConfig::differential23;
+        sample.gain = gainOf(timestamp);
+        sample.raw = rawOf(timestamp);
+        sample.timestampMicros = timestamp;
+        board.publish(sample);
+    }
+    writing = false;
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+
+    printf("Board: %u samples published, %u copies, %u empty or retried out\n", publishCount, copies.load(), emptyReads.load());
+    check(copies > 0, "the readers copied no sample");
+    check(tornCopies == 0, "a reader copied a torn sample");
+    check(board.sequenceOf(1, MuxConfig::channel0) == publishCount, "the sequence doesn't count the samples published");
+}
+
+/// Runs the acquisition thread on two simulated devices while the readers check the latest samples
+void acquisitionTest() {
+    AdsSimulator simulator;
+    simulator.addDevice(AdsAddress::gnd);
+    simulator.addDevice(AdsAddress::vcc);
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel0, 1000000);
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel1, 2000000);
+    simulator.setInputMicrovolts(AdsAddress::vcc, MuxConfig::channel0, 3000000);
+    simulator.attach();
+
+    Ads1115Plus first(AdsAddress::gnd), second(AdsAddress::vcc);
+    first.begin();
+    AdsScanner firstScanner(first), secondScanner(second);
+    firstScanner.addSlot(MuxConfig::channel0);
+    firstScanner.addSlot(MuxConfig::channel1);
+    secondScanner.addSlot(MuxConfig::channel0);
+    firstScanner.start(firstScanner.minimumPeriodMicros() + 500);
+    secondScanner.start(secondScanner.minimumPeriodMicros() + 500, 700);
+
+    AdsSampleBoard board;
+    AdsAcquisitionTask acquisition(board);
+    acquisition.addScanner(firstScanner);
+    acquisition.addScanner(secondScanner);
+
+    std::atomic<bool> reading(true);
+    std::atomic<uint32_t> copies(0), wrongSamples(0), sequenceErrors(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readerCount; i++) {
+        readers.emplace_back([&]() {
+            const byte devices[] = { 0, 0, 1 };
+            const MuxConfig muxes[] = { MuxConfig::channel0, MuxConfig::channel1, MuxConfig::channel0 };
+            const int32_t expected[] = { 1000000, 2000000, 3000000 };
+            uint32_t lastSequences[3] = { 0, 0, 0 };
+            uint32_t lastTimestamps[3] = { 0, 0, 0 };
+
+            while (reading.load(std::memory_order_relaxed)) {
+                for (int channel = 0; channel < 3; channel++) {
+                    uint32_t sequence = board.sequenceOf(devices[channel], muxes[channel]);
+                    if (sequence < lastSequences[channel]) {
+                        sequenceErrors++;
+                    }
+                    lastSequences[channel] = sequence;
+
+                    AdsSample sample;
+                    if (!board.read(devices[channel], muxes[channel], sample)) {
+                        continue;
+                    }
+                    copies++;
+                    int32_t microvolts = first.rawValueToMicrovolts(sample.raw, sample.mux, sample.gain);
+                    int32_t error = microvolts - expected[channel];
+                    if (sample.device != devices[channel] || sample.mux != muxes[channel] || error > 200 || error < -200
+                        || (int32_t)(sample.timestampMicros - lastTimestamps[channel]) < 0) {
+                        wrongSamples++;
+                    }
+                    lastTimestamps[channel] = sample.timestampMicros;
+                }
+            }
+        });
+    }
+
+    acquisition.begin();
+    delayMicroseconds(acquisitionMicros);
+    acquisition.end();
+    reading = false;
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    simulator.detach();
+
+    uint32_t published = acquisition.getPublishedSamples();
+    printf("Acquisition: %u samples published, %u copies\n", published, copies.load());
+    check(published > 1000, "the acquisition thread published too few samples");
+    check(copies > 0, "the readers copied no sample");
+    check(wrongSamples == 0, "a reader copied a wrong sample");
+    check(sequenceErrors == 0, "a sequence went backwards");
+}
+
+int main() {
+    tornReadTest();
+    acquisitionTest();
+
+    printf(failures == 0 ? "All checks passed\n" : "%d checks failed\n", failures.load());
+    return failures == 0 ? 0 : 1;
+}
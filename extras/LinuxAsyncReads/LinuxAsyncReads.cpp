@@ -0,0 +1,80 @@
+// This example shows many concurrent reads served by a single thread on Linux, with C++20 coroutines
+// Four simulated ADS1115 are used so it runs without hardware, remove the simulator to use the real bus (/dev/i2c-1)
+//
+// Build from the library folder:
+//   g++ -std=c++20 -O2 -Isrc src/*.cpp extras/LinuxAsyncReads/LinuxAsyncReads.cpp -o async_reads -lpthread
+#include <Ads1115Plus.h>
+#include <AdsReadScheduler.h>
+#include <AdsSimulator.h>
+
+#include <cstdio>
+#include <sys/resource.h>
+
+/// The number of coroutines reading concurrently
+#define SENSOR_COUNT 400
+
+/// The number of reads performed by each coroutine
+#define READS_PER_SENSOR 20
+
+/// The simulated devices and bus
+AdsSimulator simulator;
+
+/// The four devices on the bus
+Ads1115Plus devices[4] = { Ads1115Plus(AdsAddress::gnd), Ads1115Plus(AdsAddress::vcc), Ads1115Plus(AdsAddress::sda), Ads1115Plus(AdsAddress::scl) };
+
+/// Serves the reads of every coroutine
+AdsReadScheduler scheduler;
+
+/// The sum of the microvolts read, per sensor
+long long totals[SENSOR_COUNT];
+
+/// A sensor reading one channel of one device, suspended during each conversion
+AdsAsyncTask sensor(int index) {
+    Ads1115Plus &ads = devices[index % 4];
+    MuxConfig mux = (MuxConfig)(((uint16_t)4 + (index / 4) % 4) << 12);
+
+    for (int i = 0; i < READS_PER_SENSOR; i++) {
+        AdsSample sample = co_await scheduler.read(ads, mux);
+        totals[index] += ads.rawValueToMicrovolts(sample.raw, sample.mux, sample.gain);
+    }
+}
+
+/// Returns the CPU time used by the process in microseconds
+long long cpuMicros() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (long long)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+int main() {
+    const AdsAddress addresses[4] = { AdsAddress::gnd, AdsAddress::vcc, AdsAddress::sda, AdsAddress::scl };
+    for (byte i = 0; i < 4; i++) {
+        simulator.addDevice(addresses[i]);
+        for (byte channel = 0; channel < 4; channel++) {
+            simulator.setInputMicrovolts(addresses[i], (MuxConfig)(((uint16_t)4 + channel) << 12), 100000 * (i + 1) + 10000 * channel);
+        }
+    }
+    simulator.attach();
+
+    for (byte i = 0; i < 4; i++) {
+        devices[i].begin();
+        devices[i].setSampleSpeed(AdsSampleSpeed::sps860);
+    }
+
+    unsigned long startMicros = micros();
+    long long startCpu = cpuMicros();
+
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        sensor(i);
+    }
+    printf("Pending reads: %u\n", scheduler.getPendingReads());
+    scheduler.run();
+
+    unsigned long elapsed = micros() - startMicros;
+    long long cpu = cpuMicros() - startCpu;
+
+    printf("Reads: %d, conversions: %u\n", SENSOR_COUNT * READS_PER_SENSOR, scheduler.getConversionCount());
+    printf("Elapsed: %lu us, CPU: %lld us (%.1f%%)\n", elapsed, cpu, 100.0 * cpu / elapsed);
+    printf("Sensor 0 mean: %lld uV, sensor %d mean: %lld uV\n", totals[0] / READS_PER_SENSOR, SENSOR_COUNT - 1, totals[SENSOR_COUNT - 1] / READS_PER_SENSOR);
+    return 0;
+}
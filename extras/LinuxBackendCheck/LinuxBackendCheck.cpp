@@ -0,0 +1,193 @@
+// This program checks the Linux backend against the simulated bus
+// Every AdsLinuxI2c transfer is recorded before it reaches the simulator, so the checks cover both the messages
+// the driver sends (addresses, register pointers, config words) and the results it returns.
+// Exits with 1 if a check fails
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxBackendCheck/LinuxBackendCheck.cpp -o backend_check -lpthread
+#include <Ads1115Plus.h>
+#include <AdsSimulator.h>
+
+#include <cstdio>
+#include <vector>
+
+/** A message of a recorded transfer */
+struct Message {
+
+    /// The i2c address
+    uint16_t address;
+
+    /// Whether the master reads
+    bool read;
+
+    /// The bytes written, or the bytes read once the transfer is done
+    std::vector<uint8_t> data;
+};
+
+/// The simulated devices and bus
+AdsSimulator simulator;
+
+/// The transfers since the last clearTraffic()
+std::vector<std::vector<Message>> traffic;
+
+/// The number of failed checks
+int failures = 0;
+
+/// Records the [transfer] and hands it to the simulator
+int recordTransfer(struct i2c_rdwr_ioctl_data *transfer, void *) {
+    int result = simulator.transfer(transfer);
+
+    std::vector<Message> messages;
+    for (uint32_t i = 0; i < transfer->nmsgs; i++) {
+        const struct i2c_msg &message = transfer->msgs[i];
+        messages.push_back({ message.addr, (message.flags & I2C_M_RD) != 0, std::vector<uint8_t>(message.buf, message.buf + message.len) });
+    }
+    traffic.push_back(messages);
+    return result;
+}
+
+/// Prints [message] and counts a failure when [condition] is false
+void check(bool condition, const char *message) {
+    if (!condition) {
+        printf("  FAIL: %s\n", message);
+        failures++;
+    }
+}
+
+/// Returns whether the transfer at [index] is a single write of [bytes] to [address]
+bool isWrite(size_t index, uint16_t address, std::vector<uint8_t> bytes) {
+    return index < traffic.size() && traffic[index].size() == 1 && !traffic[index][0].read
+        && traffic[index][0].address == address && traffic[index][0].data == bytes;
+}
+
+/// Returns whether the transfer at [index] reads the register [reg] of [address] and got [value]
+bool isRegisterRead(size_t index, uint16_t address, uint8_t reg, uint16_t value) {
+    return index < traffic.size() && traffic[index].size() == 2
+        && !traffic[index][0].read && traffic[index][0].address == address && traffic[index][0].data == std::vector<uint8_t>{ reg }
+        && traffic[index][1].read && traffic[index][1].address == address
+        && traffic[index][1].data == std::vector<uint8_t>{ (uint8_t)(value >> 8), (uint8_t)(value & 0xFF) };
+}
+
+/// Returns whether the write of [bytes] to [address] is in the recorded traffic
+bool hasWrite(uint16_t address, std::vector<uint8_t> bytes) {
+    for (size_t i = 0; i < traffic.size(); i++) {
+        for (const Message &message : traffic[i]) {
+            if (!message.read && message.address == address && message.data == bytes) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void singleShotReads() {
+    printf("Single shot reads\n");
+    Ads1115Plus ads(AdsAddress::gnd, AdsGain::one, AdsSampleSpeed::sps860);
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel1, 1500000);
+    traffic.clear();
+
+    // OS | channel 1 | gain 1 | single shot | 860 SPS | comparator disabled = 0xD3E3, then 1.5V / 125uV = 12000
+    int16_t raw = ads.readRawOnMux(MuxConfig::channel1);
+    check(raw == 12000, "channel 1 doesn't read 12000");
+    check(traffic.size() == 2, "a single shot read isn't two transfers");
+    check(isWrite(0, 0x48, { 0x01, 0xD3, 0xE3 }), "the config written isn't 0xD3E3");
+    check(isRegisterRead(1, 0x48, 0x00, 12000), "the conversion register isn't read with a repeated start");
+
+    // Negative differential input: -0.5V / 62.5uV = -8000
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::differential01, -500000);
+    ads.setGain(AdsGain::two);
+    traffic.clear();
+    raw = ads.readRawOnMux(MuxConfig::differential01);
+    check(raw == -8000, "differential 0-1 doesn't read -8000");
+    check(isWrite(0, 0x48, { 0x01, 0x85, 0xE3 }), "the differential config written isn't 0x85E3");
+    check(ads.readMicrovoltsOnMux(MuxConfig::differential01) == -500000, "differential 0-1 doesn't read -500000uV");
+}
+
+void nonBlockingRead() {
+    printf("Non-blocking read\n");
+    Ads1115Plus ads(AdsAddress::gnd, AdsGain::twoThirds, AdsSampleSpeed::sps475);
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel3, 3000000);
+
+    ads.startSingleShotOnMux(MuxConfig::channel3);
+    check(!ads.isConversionReady(), "the conversion is ready right after being started");
+    check(simulator.getRegister(AdsAddress::gnd, 1) == 0x71C3, "the config register doesn't hold the conversion started (OS cleared while converting)");
+    delayMicroseconds(Ads1115Plus::conversionTimeMicros(AdsSampleSpeed::sps475));
+    check(ads.isConversionReady(), "the conversion isn't ready after the conversion time");
+    check(ads.getLastConversionResults() == 16000, "channel 3 doesn't read 3V / 187.5uV = 16000");
+}
+
+void comparator() {
+    printf("Comparator\n");
+    Ads1115Plus ads(AdsAddress::gnd, AdsGain::one, AdsSampleSpeed::sps860);
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel0, 1000000);
+    traffic.clear();
+
+    ads.startComparatorModeOnMux(MuxConfig::channel0, 16000, 15000);
+    check(hasWrite(0x48, { 0x03, 0x3E, 0x80 }), "the high threshold 16000 isn't written");
+    check(hasWrite(0x48, { 0x02, 0x3A, 0x98 }), "the low threshold 15000 isn't written");
+    check(simulator.getRegister(AdsAddress::gnd, 3) == 16000 && simulator.getRegister(AdsAddress::gnd, 2) == 15000, "the threshold registers don't hold the thresholds");
+
+    // Continuous conversions: 1V stays below, 2.5V (20000) asserts ALERT/RDY
+    delayMicroseconds(5000);
+    check(!simulator.isAlertAsserted(AdsAddress::gnd), "ALERT/RDY is asserted below the threshold");
+    simulator.setInputMicrovolts(AdsAddress::gnd, MuxConfig::channel0, 2500000);
+    delayMicroseconds(5000);
+    check(simulator.isAlertAsserted(AdsAddress::gnd), "ALERT/RDY isn't asserted above the threshold");
+    check(ads.getLastConversionResults() == 20000, "the continuous conversion doesn't read 20000");
+
+    ads.startSingleShotOnMux(MuxConfig::channel0); // Back to power down
+}
+
+void presenceAndReset() {
+    printf("Presence and general call reset\n");
+    check(Ads1115Plus::isResponding(AdsAddress::gnd), "the device on GND doesn't respond");
+    check(!Ads1115Plus::isResponding(AdsAddress::vcc), "an empty address responds");
+
+    Ads1115Plus ads(AdsAddress::gnd, AdsGain::four);
+    ads.readRawOnMux(MuxConfig::channel2);
+    check(!Ads1115Plus::isUnconfiguredAds1115(AdsAddress::gnd), "a configured device looks unconfigured");
+
+    traffic.clear();
+    Ads1115Plus::sendGeneralCallReset();
+    check(isWrite(0, 0x00, { 0x06 }), "the general call reset isn't 0x06 to address 0");
+    check(Ads1115Plus::isUnconfiguredAds1115(AdsAddress::gnd), "the device didn't reload its reset config");
+
+    simulator.removeDevice(AdsAddress::gnd);
+    check(!Ads1115Plus::isResponding(AdsAddress::gnd), "a removed device still responds");
+    uint8_t pointer = 0x00;
+    check(!AdsLinuxI2c::write(0x48, &pointer, 1), "a write to a removed device succeeds");
+    simulator.addDevice(AdsAddress::gnd);
+}
+
+void batchedWrites() {
+    printf("Batched writes\n");
+    Ads1115Plus ads(AdsAddress::gnd);
+    ads.forgetRegisterState();
+    traffic.clear();
+
+    AdsLinuxI2c::beginBatch();
+    ads.setThresholds(1000, -1000);
+    ads.setMuxAndMode(MuxConfig::channel1, false);
+    ads.writeConfigIfChanged();
+    check(traffic.empty(), "batched writes were sent before endBatch()");
+    check(AdsLinuxI2c::endBatch(), "the batch failed");
+
+    check(traffic.size() == 1 && traffic[0].size() == 3, "the batch isn't a single transfer of three messages");
+    check(simulator.getRegister(AdsAddress::gnd, 3) == 1000 && simulator.getRegister(AdsAddress::gnd, 2) == (uint16_t)-1000, "the batched thresholds aren't in the registers");
+    check(ads.verifyRegisters(), "the registers don't match the shadows");
+}
+
+int main() {
+    simulator.addDevice(AdsAddress::gnd);
+    AdsLinuxI2c::setTransferHook(recordTransfer, nullptr);
+
+    singleShotReads();
+    nonBlockingRead();
+    comparator();
+    presenceAndReset();
+    batchedWrites();
+
+    AdsLinuxI2c::setTransferHook(nullptr, nullptr);
+    printf(failures == 0 ? "All checks passed\n" : "%d checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// This example compares the bus traffic of configuring four devices one call at a time and with AdsBulkConfig
+// The devices are simulated, so it runs on Linux without hardware
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxBulkConfig/LinuxBulkConfig.cpp -o bulk_config -lpthread
+#include <Ads1115Plus.h>
+#include <AdsBulkConfig.h>
+#include <AdsSimulator.h>
+
+#include <cstdio>
+
+/// The simulated devices and bus
+AdsSimulator simulator;
+
+/// The addresses of the four devices
+const AdsAddress addresses[4] = { AdsAddress::gnd, AdsAddress::vcc, AdsAddress::sda, AdsAddress::scl };
+
+/// Prints the transfers and bus time since the last call
+void printBusStats(const char *label) {
+    printf("%-28s %3u transfers, %5lu us on the bus\n", label, simulator.getTransferCount(), simulator.getBusMicros());
+    simulator.resetBusStats();
+}
+
+int main() {
+    for (byte i = 0; i < 4; i++) {
+        simulator.addDevice(addresses[i]);
+    }
+    simulator.attach();
+
+    // Two devices watch a threshold, one converts continuously, one waits for single shot readings
+    {
+        Ads1115Plus devices[4] = { Ads1115Plus(addresses[0]), Ads1115Plus(addresses[1]), Ads1115Plus(addresses[2]), Ads1115Plus(addresses[3]) };
+        devices[0].begin();
+        simulator.resetBusStats();
+
+        for (byte i = 0; i < 4; i++) {
+            devices[i].setGain(AdsGain::two);
+            devices[i].setSampleSpeed(AdsSampleSpeed::sps860);
+        }
+        devices[0].startComparatorModeOnMux(MuxConfig::channel0, 16000, 15000);
+        devices[1].startComparatorModeOnMux(MuxConfig::channel1, 20000, 19000, ComparatorLatchingConfig::latching);
+        devices[2].startContinousConversionModeOnMux(MuxConfig::differential01);
+        devices[3].readRawOnMux(MuxConfig::channel2); // Legacy code configures single shot devices with a first reading
+        for (byte i = 0; i < 4; i++) {
+            devices[i].getLastConversionResults(); // Typical sanity read
+        }
+        printBusStats("One call at a time:");
+    }
+
+    Ads1115Plus devices[4] = { Ads1115Plus(addresses[0]), Ads1115Plus(addresses[1]), Ads1115Plus(addresses[2]), Ads1115Plus(addresses[3]) };
+    AdsBulkConfig config;
+    for (byte i = 0; i < 4; i++) {
+        devices[i].setGain(AdsGain::two, false);
+        devices[i].setSampleSpeed(AdsSampleSpeed::sps860, false);
+    }
+    config.addComparator(devices[0], MuxConfig::channel0, 16000, 15000);
+    config.addComparator(devices[1], MuxConfig::channel1, 20000, 19000)->comparatorLatching = ComparatorLatchingConfig::latching;
+    config.add(devices[2], AdsDeviceMode::continuous, MuxConfig::differential01);
+    config.add(devices[3], AdsDeviceMode::singleShot, MuxConfig::channel2);
+
+    AdsBulkResult result = config.apply(true, false);
+    printBusStats("Bulk, no verification:");
+    printf("  %u registers written, %u skipped\n", result.registersWritten, result.registersSkipped);
+
+    result = config.apply(true, true);
+    printBusStats("Bulk, verified:");
+    printf("  %u registers written, %u skipped, %s\n", result.registersWritten, result.registersSkipped, result.succeeded() ? "verified" : "verification failed");
+
+    // Applying again only verifies: every register already holds its value
+    result = config.apply(false, true);
+    printBusStats("Bulk again, no reset:");
+    printf("  %u registers written, %u skipped\n", result.registersWritten, result.registersSkipped);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// This program checks the statistics of AdsChannelStats against a floating point reference
+// Small noise on large DC offsets (the standard deviation must not cancel out), windows mixing the gains and a
+// full scale window too long for a 64 bit sum of squares.
+// Exits with 1 if a check fails
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxChannelStatsCheck/LinuxChannelStatsCheck.cpp -o channel_stats_check -lpthread
+#include <Ads1115Plus.h>
+#include <AdsChannelStats.h>
+
+#include <cmath>
+#include <cstdio>
+
+/// The gains, in the order of their LSB sizes
+const AdsGain gains[6] = { AdsGain::twoThirds, AdsGain::one, AdsGain::two, AdsGain::four, AdsGain::eight, AdsGain::sixteen };
+
+/// The LSB size of each gain in microvolts
+const double lsbMicrovolts[6] = { 187.5, 125, 62.5, 31.25, 15.625, 7.8125 };
+
+/// The number of failed checks
+int failures = 0;
+
+void check(bool condition, const char *message) {
+    if (!condition) {
+        printf("  FAIL: %s\n", message);
+        failures++;
+    }
+}
+
+/// Accumulates the reference statistics in long double
+struct Reference {
+    long double sum = 0;
+    long double sumSquared = 0;
+    uint32_t count = 0;
+
+    void add(int16_t raw, byte gain) {
+        long double value = raw * (long double)lsbMicrovolts[gain];
+        sum += value;
+        sumSquared += value * value;
+        count++;
+    }
+
+    double mean() const {
+        return (double)(sum / count);
+    }
+
+    double rms() const {
+        return (double)sqrtl(sumSquared / count);
+    }
+
+    double stddev() const {
+        long double mean = sum / count;
+        return (double)sqrtl(sumSquared / count - mean * mean);
+    }
+};
+
+/// Checks the snapshot of [stats] against [reference], within [tolerance] microvolts
+void checkSnapshot(AdsChannelStats &stats, const Reference &reference, double tolerance) {
+    AdsStatsSnapshot snapshot;
+    stats.snapshot(snapshot);
+    printf("  %u samples: mean %d uV, rms %d uV, stddev %d uV (expected %.1f, %.1f, %.1f)\n", snapshot.count, snapshot.meanMicrovolts, snapshot.rmsMicrovolts, snapshot.stddevMicrovolts, reference.mean(), reference.rms(), reference.stddev());
+    check(snapshot.count == reference.count, "wrong sample count");
+    check(fabs(snapshot.meanMicrovolts - reference.mean()) <= tolerance, "wrong mean");
+    check(fabs(snapshot.rmsMicrovolts - reference.rms()) <= tolerance, "wrong rms");
+    check(fabs(snapshot.stddevMicrovolts - reference.stddev()) <= tolerance, "wrong standard deviation");
+}
+
+int main() {
+    // +-1 LSB around offsets up to full scale: the standard deviation is 187.5uV whatever the offset
+    const int offsets[6] = { 0, 100, 5333, 16000, 32001, -32000 };
+    for (int offset : offsets) {
+        printf("Offset %d, +-1 LSB at 2/3\n", offset);
+        AdsChannelStats stats;
+        Reference reference;
+        for (int i = 0; i < 10000; i++) {
+            int16_t raw = (int16_t)(offset + (i & 1 ? 1 : -1));
+            stats.add(raw, AdsGain::twoThirds);
+            reference.add(raw, 0);
+        }
+        checkSnapshot(stats, reference, 1);
+    }
+
+    // Noise on an offset, the gain changing every 100000 samples
+    printf("Mixed gains\n");
+    {
+        AdsChannelStats stats;
+        Reference reference;
+        uint32_t seed = 7;
+        for (int i = 0; i < 1200000; i++) {
+            seed = seed * 1103515245 + 12345;
+            byte gain = i / 100000 % 6;
+            int16_t raw = (int16_t)(20000 + (int)((seed >> 16) % 200) - 100);
+            stats.add(raw, gains[gain]);
+            reference.add(raw, gain);
+        }
+        checkSnapshot(stats, reference, 1);
+    }
+
+    // 20 million full scale samples at 2/3: the sum of squares needs more than 64 bits
+    printf("Full scale\n");
+    {
+        AdsChannelStats stats;
+        Reference reference;
+        for (int i = 0; i < 20000000; i++) {
+            int16_t raw = i & 1 ? 32767 : -32768;
+            stats.add(raw, AdsGain::twoThirds);
+            reference.add(raw, 0);
+        }
+        checkSnapshot(stats, reference, 1);
+    }
+
+    printf(failures == 0 ? "All checks passed\n" : "%d checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
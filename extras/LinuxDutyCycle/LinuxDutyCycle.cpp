@@ -0,0 +1,71 @@
+// This example compares the supply charge of slow logging at the fastest and the slowest sample speed
+// The device is simulated: the charge it draws is compared with the estimate of AdsDutyCycleLogger
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxDutyCycle/LinuxDutyCycle.cpp -o duty_cycle -lpthread
+#include <Ads1115Plus.h>
+#include <AdsDutyCycleLogger.h>
+#include <AdsScanner.h>
+#include <AdsSimulator.h>
+
+#include <cstdio>
+
+/// The time between two reads of the scan list
+const unsigned long scanPeriodMicros = 500000;
+
+/// The time each configuration is run
+const unsigned long runMicros = 3000000;
+
+/// The number of samples logged
+uint32_t samples = 0;
+
+/// Counts the samples
+void onSample(const AdsSample &, void *) {
+    samples++;
+}
+
+/// Logs channels 0 and 1 for [runMicros] and prints the simulated and estimated charge
+void run(AdsSimulator &simulator, Ads1115Plus &ads, AdsSampleSpeed speed, const char *label) {
+    AdsScanner scanner(ads);
+    scanner.addSlot(MuxConfig::channel0, AdsGain::one, speed);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::one, speed);
+    scanner.setSampleCallback(onSample);
+
+    AdsDutyCycleLogger logger(scanner);
+    samples = 0;
+    simulator.resetEnergyStats();
+    if (!logger.start(scanPeriodMicros, speed != AdsSampleSpeed::sps860)) {
+        printf("%s: the period is too short\n", label);
+        return;
+    }
+
+    uint32_t start = micros();
+    while (micros() - start < runMicros) {
+        logger.poll();
+        uint32_t sleep = logger.sleepMicros();
+        delayMicroseconds(sleep < runMicros ? sleep : runMicros); // The host would sleep here
+    }
+    logger.stop();
+
+    AdsEnergyEstimate estimate = logger.estimate();
+    double simulated = (double)simulator.getChargeNanocoulombs(AdsAddress::gnd);
+    printf("%s: %u samples, active %lu us\n", label, samples, simulator.getActiveMicros(AdsAddress::gnd));
+    printf("  simulated %.0f nC per sample, estimated %u nC per sample, estimated average current %.2f uA\n",
+        samples > 0 ? simulated / samples : 0.0, estimate.chargePerSampleNanocoulombs, estimate.averageCurrentNanoamps / 1000.0);
+}
+
+int main() {
+    AdsSimulator simulator;
+    simulator.addDevice(AdsAddress::gnd);
+    simulator.attach();
+
+    Ads1115Plus ads;
+    ads.begin();
+
+    run(simulator, ads, AdsSampleSpeed::sps860, "860 SPS");
+    run(simulator, ads, AdsSampleSpeed::sps8, "8 SPS  ");
+
+    AdsEnergyEstimate hourly = AdsDutyCycleLogger::estimate(AdsSampleSpeed::sps860, 3600000000UL);
+    printf("One sample per hour at 860 SPS: %u nC per sample, %.3f uA average\n", hourly.chargePerSampleNanocoulombs, hourly.averageCurrentNanoamps / 1000.0);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// This example measures the power of a simulated 50Hz load from a current shunt and a voltage divider
+// The mean power of the aligned pairs is compared with the one of the same conversions taken back to back
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxPairedSampling/LinuxPairedSampling.cpp -o paired_sampling -lpthread
+#include <Ads1115Plus.h>
+#include <AdsPairedSampler.h>
+#include <AdsSimulator.h>
+
+#include <cmath>
+#include <cstdio>
+
+/// The amplitude of the voltage on the divider (channel 2)
+const double voltageMicrovolts = 2000000;
+
+/// The amplitude of the voltage on the shunt (differential 0-1), in phase with the voltage
+const double shuntMicrovolts = 200000;
+
+/// Sine waves in phase on the shunt and the divider
+class MainsSource : public AdsSignalSource {
+public:
+    int32_t inputMicrovolts(byte, MuxConfig mux, uint32_t timeMicros) override {
+        double phase = 2 * M_PI * 50 * (timeMicros % 20000) / 1000000.0;
+        if (mux == MuxConfig::differential01) {
+            return (int32_t)(shuntMicrovolts * sin(phase));
+        }
+        return mux == MuxConfig::channel2 ? (int32_t)(voltageMicrovolts * sin(phase)) : 0;
+    }
+};
+
+/// The device read
+Ads1115Plus ads;
+
+/// The sum of the aligned products (uV2) and the sum of the back to back products
+double alignedSum = 0, backToBackSum = 0;
+
+/// Accumulates the products of each pair, aligned and as the consecutive conversions would give
+void onPair(const AdsSamplePair &pair, void *context) {
+    AdsPairedSampler &sampler = *(AdsPairedSampler *)context;
+    double voltage = ads.rawValueToMicrovolts(pair.referenceRaw, sampler.getReferenceMux(), sampler.getReferenceGain());
+    double current = ads.rawValueToMicrovolts(pair.otherRaw, sampler.getOtherMux(), sampler.getOtherGain());
+    alignedSum += voltage * current;
+}
+
+int main() {
+    MainsSource source;
+    AdsSimulator simulator;
+    simulator.addDevice(AdsAddress::gnd);
+    simulator.setSignalSource(&source);
+    simulator.attach();
+    ads.begin();
+
+    AdsPairedSampler sampler(ads);
+    sampler.setInputs(MuxConfig::channel2, AdsGain::one, MuxConfig::differential01, AdsGain::sixteen);
+    sampler.setPairCallback(onPair, &sampler);
+
+    // One second of pairs
+    sampler.start();
+    uint32_t start = micros();
+    while (micros() - start < 1000000) {
+        sampler.poll();
+        delayMicroseconds(sampler.microsUntilNextEvent());
+    }
+    sampler.stop();
+    uint32_t pairs = sampler.getPairCount();
+
+    // The same number of products from the reads one after the other, as readChannel / readDifferential would do
+    ads.setSampleSpeed(AdsSampleSpeed::sps860);
+    for (uint32_t i = 0; i < pairs; i++) {
+        ads.setGain(AdsGain::one);
+        double voltage = ads.rawValueToMicrovolts(ads.readRawOnMux(MuxConfig::channel2), MuxConfig::channel2, AdsGain::one);
+        ads.setGain(AdsGain::sixteen);
+        double current = ads.rawValueToMicrovolts(ads.readRawOnMux(MuxConfig::differential01), MuxConfig::differential01, AdsGain::sixteen);
+        backToBackSum += voltage * current;
+    }
+
+    double expected = voltageMicrovolts * shuntMicrovolts / 2;
+    printf("%u pairs, one every %lu us\n", pairs, sampler.pairPeriodMicros());
+    printf("Mean shunt x divider product: expected %.4g uV2\n", expected);
+    printf("  aligned pairs: %.4g uV2 (%+.2f%%)\n", alignedSum / pairs, 100 * (alignedSum / pairs / expected - 1));
+    printf("  back to back reads: %.4g uV2 (%+.2f%%)\n", backToBackSum / pairs, 100 * (backToBackSum / pairs / expected - 1));
+
+    simulator.detach();
+    return 0;
+}
@@ -0,0 +1,162 @@
+// This program checks that sample records decode to the samples that were encoded
+// Mixed devices, channels and gains, timestamps crossing the micros() overflow and gaps too long for a sample frame
+// are encoded through a Print, then decoded intact, with a corrupted CRC and with a truncated frame.
+// Exits with 1 if a check fails
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxRecordRoundTrip/LinuxRecordRoundTrip.cpp -o record_round_trip -lpthread
+#include <Ads1115Plus.h>
+#include <AdsSampleRecord.h>
+
+#include <cstdio>
+#include <vector>
+
+/// The number of samples encoded
+const int sampleCount = 2000;
+
+/// The number of sample frames between time frames
+const uint16_t timeInterval = 32;
+
+/// The number of failed checks
+int failures = 0;
+
+/// Collects the bytes written by AdsRecordEncoder::write()
+class ByteStream : public Print {
+public:
+    std::vector<uint8_t> bytes;
+
+    size_t write(uint8_t value) override {
+        bytes.push_back(value);
+        return 1;
+    }
+};
+
+/// The position of each sample in the stream
+struct EncodedSample {
+
+    /// The sample encoded
+    AdsSample sample;
+
+    /// The offset of its first frame in the stream
+    size_t offset;
+
+    /// The size of its frames (a time frame may come first)
+    size_t size;
+};
+
+/// Prints [message] and counts a failure when [condition] is false
+void check(bool condition, const char *message) {
+    if (!condition) {
+        printf("  FAIL: %s\n", message);
+        failures++;
+    }
+}
+
+bool sameSample(const AdsSample &a, const AdsSample &b) {
+    return a.device == b.device && a.mux == b.mux && a.gain == b.gain && a.raw == b.raw && a.timestampMicros == b.timestampMicros;
+}
+
+/// Encodes the test samples, starting 40ms before the micros() overflow
+std::vector<uint8_t> encodeSamples(std::vector<EncodedSample> &encoded) {
+    ByteStream stream;
+    AdsRecordEncoder encoder(timeInterval);
+    uint32_t state = 12345;
+    uint32_t timestamp = 0xFFFFFFFF - 40000;
+
+    for (int i = 0; i < sampleCount; i++) {
+        state = state * 1103515245 + 12345;
+
+        AdsSample sample;
+        sample.device = (state >> 8) & 0x3;
+        sample.mux = (MuxConfig)((uint16_t)((state >> 10) & 0x7) << 12);
+        sample.gain = (AdsGain)((uint16_t)((state >> 13) % ADS_GAIN_COUNT) << 9);
+        sample.raw = (int16_t)(state >> 16);
+
+        // Mostly short steps, sometimes a gap that needs a time frame
+        timestamp += i % 97 == 50 ? 70000 + (state & 0xFFFF) : 1163 + ((state >> 4) & 0xFF);
+        sample.timestampMicros = timestamp;
+
+        size_t offset = stream.bytes.size();
+        size_t size = encoder.write(stream, sample);
+        encoded.push_back({ sample, offset, size });
+    }
+    return stream.bytes;
+}
+
+/// Decodes [bytes] and checks the samples against [encoded]; the samples from [firstExpected] on must all be decoded
+void decodeAndCheck(const std::vector<uint8_t> &bytes, const std::vector<EncodedSample> &encoded, int firstExpected, uint32_t expectedDropped) {
+    AdsRecordDecoder decoder;
+    int next = 0;
+    int decodedFromExpected = 0;
+    int wrongTimestamps = 0;
+    int unknownSamples = 0;
+
+    for (uint8_t value : bytes) {
+        AdsSample sample;
+        if (!decoder.feed(value, sample)) {
+            continue;
+        }
+
+        // Find the sample (samples in a lost frame are skipped)
+        int index = next;
+        while (index < (int)encoded.size() && !(encoded[index].sample.raw == sample.raw && encoded[index].sample.mux == sample.mux
+            && encoded[index].sample.gain == sample.gain && encoded[index].sample.device == sample.device)) {
+            index++;
+        }
+        if (index == (int)encoded.size()) {
+            unknownSamples++;
+            continue;
+        }
+        next = index + 1;
+
+        if (decoder.isTimeSynced() && !sameSample(sample, encoded[index].sample)) {
+            wrongTimestamps++;
+        }
+        if (index >= firstExpected) {
+            decodedFromExpected++;
+        }
+    }
+
+    check(unknownSamples == 0, "a decoded sample was never encoded");
+    check(wrongTimestamps == 0, "a sample decoded while time synced has a wrong timestamp");
+    check(decodedFromExpected == (int)encoded.size() - firstExpected, "samples are missing after the decoder re-synchronized");
+    check(decoder.getDroppedFrames() == expectedDropped, "unexpected number of dropped frames");
+    check(decoder.isTimeSynced(), "the decoder didn't get the time back");
+    printf("  %d samples checked, %u frames dropped\n", decodedFromExpected, decoder.getDroppedFrames());
+}
+
+/// Returns the index of the first sample after [index] preceded by a time frame
+int nextTimeFrame(const std::vector<EncodedSample> &encoded, int index) {
+    for (int i = index + 1; i < (int)encoded.size(); i++) {
+        if (encoded[i].size > ADS_RECORD_SAMPLE_SIZE) {
+            return i;
+        }
+    }
+    return encoded.size();
+}
+
+int main() {
+    std::vector<EncodedSample> encoded;
+    std::vector<uint8_t> bytes = encodeSamples(encoded);
+    check(encoded.back().sample.timestampMicros < encoded.front().sample.timestampMicros, "the timestamps don't cross the overflow");
+
+    printf("Intact stream (%zu bytes)\n", bytes.size());
+    decodeAndCheck(bytes, encoded, 0, 0);
+
+    // A sample frame in the middle of a time interval, with a wrong CRC
+    int corrupted = 1000 + timeInterval / 2;
+    std::vector<uint8_t> wrongCrc = bytes;
+    wrongCrc[encoded[corrupted].offset + encoded[corrupted].size - 1] ^= 0x5A;
+    printf("Sample %d with a wrong CRC\n", corrupted);
+    decodeAndCheck(wrongCrc, encoded, nextTimeFrame(encoded, corrupted), 1);
+
+    // The same sample frame without its last two bytes
+    std::vector<uint8_t> truncated = bytes;
+    size_t end = encoded[corrupted].offset + encoded[corrupted].size;
+    truncated.erase(truncated.begin() + end - 2, truncated.begin() + end);
+    printf("Sample %d truncated\n", corrupted);
+    decodeAndCheck(truncated, encoded, nextTimeFrame(encoded, corrupted), 1);
+
+    printf(failures == 0 ? "All checks passed\n" : "%d checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
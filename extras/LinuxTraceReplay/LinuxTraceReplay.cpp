@@ -0,0 +1,100 @@
+// This example replays a recorded trace through the simulated bus and benchmarks the read path with it:
+// the scanner reads the recorded channels of device 0, the samples are delta compressed and compared with the trace
+//
+// Build from the library folder:
+//   g++ -std=c++17 -O2 -Isrc src/*.cpp extras/LinuxTraceReplay/LinuxTraceReplay.cpp -o trace_replay -lpthread
+// Run with a CSV trace ("timestampMicros,device,mux index,gain index,raw") or a file of AdsRecordEncoder frames (.bin):
+//   ./trace_replay trace.csv [speed]
+// Without a file a synthetic trace (two channels, 1 second) is written to synthetic_trace.csv and replayed
+// Linux isn't a realtime OS: a wake-up later than the period margin skips a grid point, so a few overruns per second are
+// expected (the replay follows the clock, the trace time isn't shifted by them)
+#include <Ads1115Plus.h>
+#include <AdsDeltaCompressor.h>
+#include <AdsScanner.h>
+#include <AdsSimulator.h>
+#include <AdsTraceReplay.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+/// Compresses the samples read
+AdsDeltaEncoder encoder;
+
+/// The number of samples read
+uint32_t samplesRead = 0;
+
+/// The number of compressed bytes
+uint32_t compressedBytes = 0;
+
+/// Compresses each sample produced by the scanner
+void onSample(const AdsSample &sample, void *) {
+    uint8_t buffer[ADS_DELTA_MAX_BYTES_PER_VALUE];
+    compressedBytes += encoder.encode(AdsDeltaEncoder::channelOf(sample), sample.raw, buffer);
+    samplesRead++;
+}
+
+/// Writes a 1 second trace: a 50Hz sine on channel 0 and a slow ramp on channel 1, 860 samples per second each
+bool writeSyntheticTrace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "# timestampMicros,device,mux index,gain index,raw\n");
+    for (int i = 0; i < 860; i++) {
+        unsigned long time = i * 1163UL;
+        fprintf(file, "%lu,0,4,1,%d\n", time, (int)(12000 * sin(2 * M_PI * 50 * time / 1e6)));
+        fprintf(file, "%lu,0,5,1,%d\n", time, i * 20);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "synthetic_trace.csv";
+    double speed = argc > 2 ? atof(argv[2]) : 1;
+    if (argc == 1 && !writeSyntheticTrace(path)) {
+        printf("Couldn't write %s\n", path);
+        return 1;
+    }
+
+    AdsTraceReplay trace;
+    size_t length = strlen(path);
+    bool loaded = length > 4 && strcmp(path + length - 4, ".bin") == 0 ? trace.loadRecords(path) : trace.loadCsv(path);
+    if (!loaded || trace.getSampleCount() == 0) {
+        printf("Couldn't load a trace from %s\n", path);
+        return 1;
+    }
+    printf("Loaded %zu samples, %lu us long, replayed at %.1fx\n", trace.getSampleCount(), (unsigned long)trace.getDurationMicros(), speed);
+
+    AdsSimulator simulator;
+    simulator.addDevice(AdsAddress::gnd);
+    simulator.setSignalSource(&trace);
+    simulator.attach();
+
+    // Read the first two single ended channels at the recorded gain, as fast as the device allows
+    Ads1115Plus ads(AdsAddress::gnd, AdsGain::one, AdsSampleSpeed::sps860);
+    ads.begin();
+    AdsScanner scanner(ads);
+    scanner.addSlot(MuxConfig::channel0, AdsGain::one);
+    scanner.addSlot(MuxConfig::channel1, AdsGain::one);
+    scanner.setSampleCallback(onSample);
+
+    trace.setSpeed(speed);
+    trace.start();
+    // The period covers the conversion, the two simulated i2c transfers (about 220us) and a margin for the wake-up latency
+    scanner.start(scanner.minimumPeriodMicros() + 500);
+
+    while (!trace.isFinished()) {
+        scanner.poll();
+        delayMicroseconds(scanner.microsUntilNextEvent());
+    }
+    scanner.stop();
+
+    AdsJitterStats jitter = scanner.getJitterStats();
+    printf("Samples read: %u, compressed to %u bytes (%.2f bytes per sample)\n", samplesRead, compressedBytes, samplesRead > 0 ? (double)compressedBytes / samplesRead : 0.0);
+    printf("Start jitter: mean %.1f us, max %u us\n", jitter.meanMicros(), jitter.maxMicros);
+    printf("Overruns: %u of %u grid points (late wake-ups of the host, expected without a realtime scheduler)\n", jitter.overruns, samplesRead + jitter.overruns);
+    printf("Bus: %u transfers, %lu us\n", simulator.getTransferCount(), simulator.getBusMicros());
+    return 0;
+}
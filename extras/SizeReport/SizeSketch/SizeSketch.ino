@@ -0,0 +1,16 @@
+// The sketch measured by size_report.sh: a channel read and converted to microvolts, builds with every configuration
+#include <Ads1115Plus.h>
+
+/// The reference to the ADS object
+Ads1115Plus ads;
+
+/// Keeps the reading from being optimized away
+volatile int32_t microvolts = 0;
+
+void setup() {
+    ads.begin(); // Start I2C communication
+}
+
+void loop() {
+    microvolts = ads.rawValueToMicrovolts(ads.readRawOnMux(MuxConfig::channel0), MuxConfig::channel0, ads.getGain());
+}
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Prints the flash used by each compile time trimming configuration (see the top of Ads1115Plus.h)
+#
+# With arduino-cli and the arduino:avr core installed, SizeSketch is built for the board in FQBN (an Uno by default)
+# and the flash reported by the build is printed. Otherwise the library is built on the host with g++ -Os, printing
+# the text size of the driver object (every method compiled) and of SizeSketch linked with --gc-sections.
+# The host numbers aren't AVR sizes, use them to compare the configurations.
+#
+# Usage, from the library folder: sh extras/SizeReport/size_report.sh
+#   FQBN=arduino:avr:nano sh extras/SizeReport/size_report.sh
+
+LIBRARY=$(cd "$(dirname "$0")/../.." && pwd)
+SKETCH="$LIBRARY/extras/SizeReport/SizeSketch"
+FQBN=${FQBN:-arduino:avr:uno}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+CONFIGS="default
+-DADS1115PLUS_NO_LEGACY_API
+-DADS1115PLUS_NO_DIFFERENTIAL_HELPERS
+-DADS1115PLUS_NO_FLOAT
+-DADS1115PLUS_NO_LEGACY_API -DADS1115PLUS_NO_DIFFERENTIAL_HELPERS -DADS1115PLUS_NO_FLOAT"
+
+if command -v arduino-cli >/dev/null 2>&1 && arduino-cli core list 2>/dev/null | grep -q "arduino:avr"; then
+    echo "SizeSketch on $FQBN (arduino-cli)"
+    printf "%-10s %s\n" "flash" "configuration"
+    echo "$CONFIGS" | while read -r config; do
+        flags=$config
+        [ "$config" = "default" ] && flags=""
+        output=$(arduino-cli compile --fqbn "$FQBN" --library "$LIBRARY" --build-path "$WORK/build" \
+            --build-property "compiler.cpp.extra_flags=$flags" "$SKETCH" 2>&1)
+        flash=$(echo "$output" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+        printf "%-10s %s\n" "${flash:-failed}" "$config"
+    done
+    exit 0
+fi
+
+CXX=${CXX:-g++}
+if ! command -v "$CXX" >/dev/null 2>&1; then
+    echo "Neither arduino-cli (with arduino:avr) nor $CXX found"
+    exit 1
+fi
+
+echo "Host build ($CXX -Os), no arduino-cli with the arduino:avr core found"
+printf "%-10s %-10s %s\n" "driver" "sketch" "configuration"
+printf 'void setup();\nvoid loop();\nint main() { setup(); loop(); return 0; }\n' > "$WORK/main.cpp"
+echo "$CONFIGS" | while read -r config; do
+    flags=$config
+    [ "$config" = "default" ] && flags=""
+    CXXFLAGS="-std=gnu++17 -Os -ffunction-sections -fdata-sections $flags -I$LIBRARY/src"
+
+    rm -f "$WORK"/*.o
+    failed=""
+    for source in "$LIBRARY"/src/*.cpp; do
+        $CXX $CXXFLAGS -c "$source" -o "$WORK/$(basename "$source" .cpp).o" || failed=1
+    done
+    $CXX $CXXFLAGS -x c++ -c "$SKETCH/SizeSketch.ino" -o "$WORK/SizeSketch.o" || failed=1
+    $CXX $CXXFLAGS -c "$WORK/main.cpp" -o "$WORK/main.o" || failed=1
+    if [ -n "$failed" ] || ! $CXX -Wl,--gc-sections "$WORK"/*.o -o "$WORK/sketch" -lpthread; then
+        printf "%-10s %-10s %s\n" "failed" "failed" "$config"
+        continue
+    fi
+
+    driver=$(size "$WORK/Ads1115Plus.o" | awk 'NR == 2 { print $1 }')
+    sketch=$(size "$WORK/sketch" | awk 'NR == 2 { print $1 }')
+    printf "%-10s %-10s %s\n" "$driver" "$sketch" "$config"
+done
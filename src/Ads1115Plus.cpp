@@ -13,8 +13,36 @@
 
 
 #include "Ads1115Plus.h"
+#include "AdsCalibration.h"
 
 
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+void Ads1115Plus::writeToAds(byte i2cAddress, byte reg, uint16_t value) {
+    uint8_t data[3] = { reg, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF) };
+    AdsLinuxI2c::write(i2cAddress, data, sizeof(data));
+}
+
+
+uint16_t Ads1115Plus::readFromAds(byte i2cAddress, byte reg) {
+    uint16_t value = 0;
+    tryReadFromAds(i2cAddress, reg, value);
+    return value;
+}
+
+
+bool Ads1115Plus::tryReadFromAds(byte i2cAddress, byte reg, uint16_t &value) {
+    // Pointer write and read in a single I2C_RDWR transfer (repeated start)
+    uint8_t data[2];
+    if (!AdsLinuxI2c::writeRead(i2cAddress, reg, data, sizeof(data))) {
+        return false;
+    }
+    value = ((uint16_t)data[0] << 8) | data[1];
+    return true;
+}
+
+#else
+
 byte Ads1115Plus::i2cReadByte() {
 #if ARDUINO >= 100
     return Wire.read();
@@ -47,9 +75,31 @@ uint16_t Ads1115Plus::readFromAds(byte i2cAddress, byte reg) {
     i2cWriteByte(reg);
     Wire.endTransmission();
     Wire.requestFrom(i2cAddress, (byte)2);
-    return ((i2cReadByte() << 8) | i2cReadByte());
+    // Read the bytes in two statements, the evaluation order of the operands of | is unspecified
+    uint16_t msb = i2cReadByte();
+    return (msb << 8) | i2cReadByte();
+}
+
+
+bool Ads1115Plus::tryReadFromAds(byte i2cAddress, byte reg, uint16_t &value) {
+    Wire.beginTransmission(i2cAddress);
+    i2cWriteByte(reg);
+    if (Wire.endTransmission() != 0) {
+        return false;
+    }
+
+    if (Wire.requestFrom(i2cAddress, (byte)2) != 2) {
+        return false;
+    }
+
+    // Read the bytes in two statements, the evaluation order of the operands of | is unspecified
+    uint16_t msb = i2cReadByte();
+    value = (msb << 8) | i2cReadByte();
+    return true;
 }
 
+#endif
+
 
 Ads1115Plus::Ads1115Plus(AdsAddress address, AdsGain gain, AdsSampleSpeed dataRate) {
     this->address = (byte)address;
@@ -64,13 +114,69 @@ Ads1115Plus::Ads1115Plus(AdsAddress address, AdsGain gain, AdsSampleSpeed dataRa
     adsMode = (uint16_t)AdsModeConfig::singleShotConversion;
     muxConfig = (uint16_t) MuxConfig::channel0;
     osConfig = (uint16_t)OsConfig::startSingleConversion;
+    calibration = nullptr;
+    forgetRegisterState();
+    highThresholdMicrovolts = 0;
+    lowThresholdMicrovolts = 0;
+    thresholdsInMicrovolts = false;
+}
+
+#if defined(ADS1115PLUS_LINUX_I2C)
 
+void Ads1115Plus::begin() {
+    if (!AdsLinuxI2c::isOpen()) {
+        AdsLinuxI2c::open(ADS_LINUX_DEFAULT_I2C_DEVICE);
+    }
 }
 
+bool Ads1115Plus::begin(const char *i2cDevice) {
+    return AdsLinuxI2c::open(i2cDevice);
+}
+
+#else
+
 void Ads1115Plus::begin() {
     Wire.begin();
 }
 
+#endif
+
+AdsAddress Ads1115Plus::getAddress() {
+    return (AdsAddress)address;
+}
+
+// MARK: Device detection
+
+bool Ads1115Plus::isResponding(AdsAddress address) {
+#if defined(ADS1115PLUS_LINUX_I2C)
+    // A single byte read, i2c-dev adapters don't always support empty transfers
+    uint8_t data;
+    return AdsLinuxI2c::read((byte)address, &data, 1);
+#else
+    Wire.beginTransmission((byte)address);
+    return Wire.endTransmission() == 0;
+#endif
+}
+
+bool Ads1115Plus::isUnconfiguredAds1115(AdsAddress address) {
+    uint16_t configRegister;
+    if (!tryReadFromAds((byte)address, (byte)AddressPointerReg::configRegister, configRegister)) {
+        return false;
+    }
+    return configRegister == ADS_CONFIG_RESET_VALUE;
+}
+
+void Ads1115Plus::sendGeneralCallReset() {
+#if defined(ADS1115PLUS_LINUX_I2C)
+    uint8_t command = 0x06;
+    AdsLinuxI2c::write(0x00, &command, 1);
+#else
+    Wire.beginTransmission((byte)0x00);
+    i2cWriteByte((byte)0x06);
+    Wire.endTransmission();
+#endif
+}
+
 // MARK: Config getter and setters
 
 AdsGain Ads1115Plus::getGain() {
@@ -88,6 +194,22 @@ AdsSampleSpeed Ads1115Plus::getSampleSpeed() {
     return (AdsSampleSpeed)sampleSpeed;
 }
 
+void Ads1115Plus::setMux(MuxConfig mux, bool updateConfig) {
+    muxConfig = (uint16_t)mux;
+    if (updateConfig && (AdsModeConfig)adsMode == AdsModeConfig::continuousConversion) {
+        writeCurrentConfig();
+    }
+}
+
+MuxConfig Ads1115Plus::getMux() {
+    return (MuxConfig)muxConfig;
+}
+
+unsigned long Ads1115Plus::samplePeriodMicros(AdsSampleSpeed speed) {
+    static const uint16_t samplesPerSecond[] = { 8, 16, 32, 64, 128, 250, 475, 860 };
+    return 1000000UL / samplesPerSecond[((uint16_t)speed >> 5) & 0x7];
+}
+
 void Ads1115Plus::setSampleSpeed(AdsSampleSpeed speed, bool updateConfig) {
     sampleSpeed = (uint16_t)speed;
     if (updateConfig && (AdsModeConfig)adsMode == AdsModeConfig::continuousConversion) {
@@ -142,16 +264,19 @@ ComparatorAssertConfig Ads1115Plus::getComparatorAssert() {
 
 // MARK: Continous conversion mode
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
 void Ads1115Plus::startComparator_SingleEnded(byte channel, uint16_t highThreshold, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
     uint16_t lowThreshold = highThreshold > DEFAULT_LOW_THRESHOLD_DIFF ? highThreshold - DEFAULT_LOW_THRESHOLD_DIFF : 0;
     startComparatorMode(channel, highThreshold, lowThreshold, comparatorLatching, comparatorMode, comparatorPolarity, comparatorQueue);
 }
+#endif
 
 void Ads1115Plus::startComparatorMode(byte channel, uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
     uint16_t mux = muxConfigOfSingleChannel(channel);
     startComparatorModeOnMux((MuxConfig)mux, highThreshold, lowThreshold, comparatorLatching, comparatorMode, comparatorPolarity, comparatorQueue);
 }
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
 void Ads1115Plus::startComparatorMode01(uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
     startComparatorModeOnMux(MuxConfig::differential01, highThreshold, lowThreshold, comparatorLatching, comparatorMode, comparatorPolarity, comparatorQueue);
 }
@@ -167,6 +292,7 @@ void Ads1115Plus::startComparatorMode13(uint16_t highThreshold, uint16_t lowThre
 void Ads1115Plus::startComparatorMode23(uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
     startComparatorModeOnMux(MuxConfig::differential23, highThreshold, lowThreshold, comparatorLatching, comparatorMode, comparatorPolarity, comparatorQueue);
 }
+#endif
 
 void Ads1115Plus::startComparatorModeOnMux(MuxConfig mux, uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
     muxConfig = (uint16_t)mux;
@@ -176,19 +302,36 @@ void Ads1115Plus::startComparatorModeOnMux(MuxConfig mux, uint16_t highThreshold
     this->comparatorPolarity = (uint16_t)comparatorPolarity;
     adsMode = (uint16_t)AdsModeConfig::continuousConversion;
 
-    // Write the high and low thresholds to the ADS
-    writeToAds(address, (byte)AddressPointerReg::highThresholdRegister, highThreshold);
-    writeToAds(address, (byte)AddressPointerReg::lowThresholdRegister, lowThreshold);
+    // Write the high and low thresholds to the ADS (always, the shadows only skip writes for the opt-in calls)
+    thresholdsInMicrovolts = false;
+    writeRegister(AddressPointerReg::highThresholdRegister, highThreshold);
+    writeRegister(AddressPointerReg::lowThresholdRegister, lowThreshold);
 
     // Write the new configuration
     writeCurrentConfig();
 }
 
+void Ads1115Plus::startComparatorModeMicrovolts(MuxConfig mux, int32_t highMicrovolts, int32_t lowMicrovolts, ComparatorLatchingConfig comparatorLatching, ComparatorModeConfig comparatorMode, ComparatorPolarityConfig comparatorPolarity, ComparatorAssertConfig comparatorQueue) {
+    muxConfig = (uint16_t)mux;
+    comparatorAssertConfig = (uint16_t)comparatorQueue;
+    this->comparatorLatching = (uint16_t)comparatorLatching;
+    this->comparatorMode = (uint16_t)comparatorMode;
+    this->comparatorPolarity = (uint16_t)comparatorPolarity;
+    adsMode = (uint16_t)AdsModeConfig::continuousConversion;
+
+    // The thresholds are converted for the new mux and gain when the config is written
+    highThresholdMicrovolts = highMicrovolts;
+    lowThresholdMicrovolts = lowMicrovolts;
+    thresholdsInMicrovolts = true;
+    writeCurrentConfig();
+}
+
 void Ads1115Plus::startContinousConversionMode(byte channel) {
     MuxConfig mux = (MuxConfig)muxConfigOfSingleChannel(channel);
     startContinousConversionModeOnMux(mux);
 }
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
 void Ads1115Plus::startContinousConversionMode01() {
     startContinousConversionModeOnMux(MuxConfig::differential01);
 }
@@ -204,6 +347,7 @@ void Ads1115Plus::startContinousConversionMode13() {
 void Ads1115Plus::startContinousConversionMode23() {
     startContinousConversionModeOnMux(MuxConfig::differential23);
 }
+#endif
 
 void Ads1115Plus::startContinousConversionModeOnMux(MuxConfig mux) {
 
@@ -216,21 +360,42 @@ void Ads1115Plus::startContinousConversionModeOnMux(MuxConfig mux) {
     writeCurrentConfig();
 }
 
+void Ads1115Plus::startConversionReadyModeOnMux(MuxConfig mux) {
+    muxConfig = (uint16_t)mux;
+    comparatorAssertConfig = (uint16_t)ComparatorAssertConfig::assertAfterOne;
+    comparatorLatching = (uint16_t)ComparatorLatchingConfig::nonLatching;
+    adsMode = (uint16_t)AdsModeConfig::continuousConversion;
+
+    // Hi_thresh MSB = 1 and Lo_thresh MSB = 0 turn the ALRT pin into a conversion ready pin (see datasheet 9.3.8)
+    thresholdsInMicrovolts = false;
+    writeRegister(AddressPointerReg::highThresholdRegister, 0x8000);
+    writeRegister(AddressPointerReg::lowThresholdRegister, 0x0000);
+    writeCurrentConfig();
+}
+
 int16_t Ads1115Plus::getLastConversionResults() {
     return (int16_t)readFromAds(address, (byte) AddressPointerReg::conversionRegister);
 }
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::getLastConversionMillivolts() {
     return getLastConversionResults() * millivoltsPerRawValue();
 }
+#endif
+
+AdsSample Ads1115Plus::getLastConversionSample() {
+    AdsSample sample;
+    sample.raw = getLastConversionResults();
+    sample.timestampMicros = micros();
+    sample.device = address - (byte)AdsAddress::gnd;
+    sample.mux = (MuxConfig)muxConfig;
+    sample.gain = (AdsGain)gain;
+    return sample;
+}
 
 // MARK: Read channels
 
 uint16_t Ads1115Plus::readChannelRaw(byte channel) {
-    return readADC_singleEnded(channel);
-}
-
-uint16_t Ads1115Plus::readADC_singleEnded(byte channel) {
     if (channel > 3) {
         // TODO: Try look at exceptions config or find a different value
         return 0;
@@ -241,6 +406,13 @@ uint16_t Ads1115Plus::readADC_singleEnded(byte channel) {
     return currentConfigSingleShotRead();
 }
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
+uint16_t Ads1115Plus::readADC_singleEnded(byte channel) {
+    return readChannelRaw(channel);
+}
+#endif
+
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
 int16_t Ads1115Plus::readDifferentialRaw01() {
     muxConfig = (uint16_t) MuxConfig::differential01;
     return currentConfigSingleShotRead();
@@ -260,15 +432,19 @@ int16_t Ads1115Plus::readDifferentialRaw23() {
     muxConfig = (uint16_t) MuxConfig::differential23;
     return currentConfigSingleShotRead();
 }
+#endif
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
 int16_t Ads1115Plus::readADC_Differential_2_3() {
-    return readDifferentialRaw23();
+    return readRawOnMux(MuxConfig::differential23);
 }
 
 int16_t Ads1115Plus::readADC_Differential_0_1() {
-    return readDifferentialRaw01();
+    return readRawOnMux(MuxConfig::differential01);
 }
+#endif
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS) && !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::readDifferentialMillivolts01() {
     return millivoltsPerRawValue() * readDifferentialRaw01();
 }
@@ -284,22 +460,87 @@ double Ads1115Plus::readDifferentialMillivolts13() {
 double Ads1115Plus::readDifferentialMillivolts23() {
     return millivoltsPerRawValue() * readDifferentialRaw23();
 }
+#endif
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::readChannelMillivolts(byte channel) {
     uint16_t channelValue = readChannelRaw(channel);
     double millivoltsPerBit = millivoltsPerRawValue();
 
     return channelValue * millivoltsPerBit;
 }
+#endif
 
 int16_t Ads1115Plus::readRawOnMux(MuxConfig mux) {
     muxConfig = (uint16_t)mux;
     return currentConfigSingleShotRead();
 }
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::readMillivoltsOnMux(MuxConfig mux) {
     return readRawOnMux(mux) * millivoltsPerRawValue();
 }
+#endif
+
+AdsSample Ads1115Plus::readSampleOnMux(MuxConfig mux) {
+    AdsSample sample;
+    sample.raw = readRawOnMux(mux);
+    sample.timestampMicros = micros();
+    sample.device = address - (byte)AdsAddress::gnd;
+    sample.mux = mux;
+    sample.gain = (AdsGain)gain;
+    return sample;
+}
+
+// MARK: Non-blocking reading
+
+void Ads1115Plus::startSingleShotOnMux(MuxConfig mux) {
+    muxConfig = (uint16_t)mux;
+    adsMode = (uint16_t)AdsModeConfig::singleShotConversion;
+    writeCurrentConfig();
+}
+
+bool Ads1115Plus::isConversionReady() {
+    uint16_t configRegister = readFromAds(address, (byte)AddressPointerReg::configRegister);
+    return (configRegister & (uint16_t)OsConfig::notPerformingConversion) != 0;
+}
+
+unsigned long Ads1115Plus::conversionTimeMicros() {
+    return conversionTimeMicros((AdsSampleSpeed)sampleSpeed);
+}
+
+unsigned long Ads1115Plus::conversionTimeMicros(AdsSampleSpeed speed) {
+    // 1 / data rate + 10% (data rate tolerance) + 50us (wake up)
+    switch (speed) {
+
+    case AdsSampleSpeed::sps8:
+        return 137550;
+
+    case AdsSampleSpeed::sps16:
+        return 68800;
+
+    case AdsSampleSpeed::sps32:
+        return 34425;
+
+    case AdsSampleSpeed::sps64:
+        return 17238;
+
+    case AdsSampleSpeed::sps128:
+        return 8644;
+
+    case AdsSampleSpeed::sps250:
+        return 4450;
+
+    case AdsSampleSpeed::sps475:
+        return 2366;
+
+    case AdsSampleSpeed::sps860:
+        return 1330;
+
+    default:
+        return 137550; // return the max time in case the rate is not recognized
+    }
+}
 
 void Ads1115Plus::clearComparatorLatch() {
     getLastConversionResults();
@@ -308,10 +549,128 @@ void Ads1115Plus::clearComparatorLatch() {
 // MARK: Public - Utility methods
 
 void Ads1115Plus::writeCurrentConfig() {
+    updateMicrovoltThresholds();
     uint16_t configRegister = buildConfigRegister();
     writeToAds(address, (byte)AddressPointerReg::configRegister, configRegister);
+    registerShadows[(byte)AddressPointerReg::configRegister] = configRegister & 0x7FFF;
+    validShadows |= 1 << (byte)AddressPointerReg::configRegister;
+}
+
+void Ads1115Plus::writeRegister(AddressPointerReg reg, uint16_t value) {
+    byte index = (byte)reg;
+    writeToAds(address, index, value);
+    registerShadows[index] = value;
+    validShadows |= 1 << index;
+}
+
+bool Ads1115Plus::writeRegisterIfChanged(AddressPointerReg reg, uint16_t value) {
+    byte index = (byte)reg;
+    if ((validShadows & (1 << index)) && registerShadows[index] == value) {
+        return false;
+    }
+    writeRegister(reg, value);
+    return true;
+}
+
+// MARK: Register shadows
+
+void Ads1115Plus::assumeResetState() {
+    registerShadows[(byte)AddressPointerReg::configRegister] = ADS_CONFIG_RESET_VALUE & 0x7FFF;
+    registerShadows[(byte)AddressPointerReg::lowThresholdRegister] = 0x8000;
+    registerShadows[(byte)AddressPointerReg::highThresholdRegister] = 0x7FFF;
+    validShadows = (1 << (byte)AddressPointerReg::configRegister) | (1 << (byte)AddressPointerReg::lowThresholdRegister) | (1 << (byte)AddressPointerReg::highThresholdRegister);
+}
+
+void Ads1115Plus::forgetRegisterState() {
+    for (byte i = 0; i < 4; i++) {
+        registerShadows[i] = 0;
+    }
+    validShadows = 0;
+}
+
+void Ads1115Plus::setMuxAndMode(MuxConfig mux, bool continuousConversion) {
+    muxConfig = (uint16_t)mux;
+    adsMode = (uint16_t)(continuousConversion ? AdsModeConfig::continuousConversion : AdsModeConfig::singleShotConversion);
+}
+
+byte Ads1115Plus::setThresholds(int16_t highThreshold, int16_t lowThreshold) {
+    thresholdsInMicrovolts = false;
+    return writeThresholds(highThreshold, lowThreshold);
+}
+
+byte Ads1115Plus::setThresholdsMicrovolts(int32_t highMicrovolts, int32_t lowMicrovolts) {
+    highThresholdMicrovolts = highMicrovolts;
+    lowThresholdMicrovolts = lowMicrovolts;
+    thresholdsInMicrovolts = true;
+    return writeThresholds(microvoltsToRawValue(highMicrovolts), microvoltsToRawValue(lowMicrovolts));
+}
+
+int32_t Ads1115Plus::getHighThresholdMicrovolts() {
+    if (thresholdsInMicrovolts) {
+        return highThresholdMicrovolts;
+    }
+    return rawValueToMicrovolts((int16_t)registerShadows[(byte)AddressPointerReg::highThresholdRegister]);
 }
 
+int32_t Ads1115Plus::getLowThresholdMicrovolts() {
+    if (thresholdsInMicrovolts) {
+        return lowThresholdMicrovolts;
+    }
+    return rawValueToMicrovolts((int16_t)registerShadows[(byte)AddressPointerReg::lowThresholdRegister]);
+}
+
+byte Ads1115Plus::writeThresholds(int16_t highThreshold, int16_t lowThreshold) {
+    byte written = 0;
+    if (writeRegisterIfChanged(AddressPointerReg::highThresholdRegister, (uint16_t)highThreshold)) {
+        written++;
+    }
+    if (writeRegisterIfChanged(AddressPointerReg::lowThresholdRegister, (uint16_t)lowThreshold)) {
+        written++;
+    }
+    return written;
+}
+
+void Ads1115Plus::updateMicrovoltThresholds() {
+    if (!thresholdsInMicrovolts || (ComparatorAssertConfig)comparatorAssertConfig == ComparatorAssertConfig::disableAndSetHighImpedance) {
+        return;
+    }
+    // Free when nothing changed: the shadows skip the writes
+    writeThresholds(microvoltsToRawValue(highThresholdMicrovolts), microvoltsToRawValue(lowThresholdMicrovolts));
+}
+
+bool Ads1115Plus::writeConfigIfChanged() {
+    updateMicrovoltThresholds();
+
+    // OS cleared: writing the config doesn't start a single shot conversion
+    return writeRegisterIfChanged(AddressPointerReg::configRegister, buildConfigRegister() & 0x7FFF);
+}
+
+bool Ads1115Plus::verifyRegisters() {
+    bool matching = true;
+    for (byte index = (byte)AddressPointerReg::configRegister; index <= (byte)AddressPointerReg::highThresholdRegister; index++) {
+        if (!(validShadows & (1 << index))) {
+            continue;
+        }
+
+        uint16_t value;
+        if (!tryReadFromAds(address, index, value)) {
+            forgetRegisterState();
+            return false;
+        }
+
+        // The OS bit of the config reads the conversion state, not what was written
+        if (index == (byte)AddressPointerReg::configRegister) {
+            value &= 0x7FFF;
+        }
+        if (value != registerShadows[index]) {
+            validShadows &= ~(1 << index);
+            matching = false;
+        }
+    }
+    return matching;
+}
+
+#if !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::millivoltsPerRawValue() {
     return millivoltsPerRawValue((AdsGain)gain);
 }
@@ -330,7 +689,7 @@ double Ads1115Plus::millivoltsPerRawValue(AdsGain gain) {
         return 0.0625;
     
     case AdsGain::four:
-        return 0.03215;
+        return 0.03125;
     
     case AdsGain::eight:
         return 0.015625;
@@ -342,6 +701,7 @@ double Ads1115Plus::millivoltsPerRawValue(AdsGain gain) {
         return 0;
     }
 }
+#endif
 
 
 // MARK: Private methods
@@ -365,8 +725,13 @@ uint16_t Ads1115Plus::muxConfigOfSingleChannel(byte channel) {
 
 int16_t Ads1115Plus::currentConfigSingleShotRead() {
     writeCurrentConfig();
+#if defined(ADS1115PLUS_LINUX_I2C)
+    // Sleeps with clock_nanosleep, so the wait can follow the conversion time to the microsecond
+    delayMicroseconds(conversionTimeMicros());
+#else
     unsigned long readingDelay = delayForChannelReading();
     delay(readingDelay);
+#endif
 
     return readFromAds(address, (byte)AddressPointerReg::conversionRegister);
 }
@@ -416,6 +781,7 @@ uint16_t Ads1115Plus::buildConfigRegister() {
         osConfig; // bit 15
 }
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
 double Ads1115Plus::rawValueToMillivolts(int16_t rawValue) {
     return rawValueToMillivolts(rawValue, (AdsGain) gain);
 }
@@ -429,5 +795,86 @@ double Ads1115Plus::millivoltsToRawValue(double millivolts) {
 }
 
 double Ads1115Plus::millivoltsToRawValue(double millivolts, AdsGain gain) {
-    return millivolts / millivoltsPerRawValue(gain);
-}
\ No newline at end of file
+    return round(millivolts / millivoltsPerRawValue(gain));
+}
+#endif
+// MARK: Integer conversion (microvolts)
+
+void Ads1115Plus::setCalibration(const AdsCalibration *calibration) {
+    this->calibration = calibration;
+}
+
+const AdsCalibration *Ads1115Plus::getCalibration() {
+    return calibration;
+}
+
+int32_t Ads1115Plus::rawValueToMicrovolts(int16_t rawValue) {
+    return rawValueToMicrovolts(rawValue, (MuxConfig)muxConfig, (AdsGain)gain);
+}
+
+int32_t Ads1115Plus::rawValueToMicrovolts(int16_t rawValue, MuxConfig mux, AdsGain gain) {
+    if (calibration != nullptr) {
+        return calibration->toMicrovolts(rawValue, mux, gain);
+    }
+    byte shift = microvoltsShift(gain);
+    return ((int32_t)rawValue * microvoltsMultiplier(gain) + ((int32_t)1 << (shift - 1))) >> shift;
+}
+
+int16_t Ads1115Plus::microvoltsToRawValue(int32_t microvolts) {
+    return microvoltsToRawValue(microvolts, (MuxConfig)muxConfig, (AdsGain)gain);
+}
+
+int16_t Ads1115Plus::microvoltsToRawValue(int32_t microvolts, MuxConfig mux, AdsGain gain) {
+    if (calibration != nullptr) {
+        return calibration->toRawValue(microvolts, mux, gain);
+    }
+    return fixedPointToRawValue(microvolts, microvoltsMultiplier(gain), microvoltsShift(gain));
+}
+
+int32_t Ads1115Plus::readMicrovoltsOnMux(MuxConfig mux) {
+    return rawValueToMicrovolts(readRawOnMux(mux));
+}
+
+int32_t Ads1115Plus::readChannelMicrovolts(byte channel) {
+    return rawValueToMicrovolts(readChannelRaw(channel));
+}
+
+int32_t Ads1115Plus::getLastConversionMicrovolts() {
+    return rawValueToMicrovolts(getLastConversionResults());
+}
+
+uint16_t Ads1115Plus::microvoltsMultiplier(AdsGain gain) {
+    // 187.5uV * 2^7, the other gains use LSB * 2^shift = 32000
+    return gain == AdsGain::twoThirds ? 24000 : 32000;
+}
+
+byte Ads1115Plus::microvoltsShift(AdsGain gain) {
+    // LSB size halves with each gain step, so the shift grows by one
+    return 7 + gainIndex(gain);
+}
+
+int16_t Ads1115Plus::fixedPointToRawValue(int32_t microvolts, uint16_t multiplier, byte shift) {
+    // Clamp a bit beyond the full scale first, so microvolts << shift fits an int32
+    int32_t limit = ((int32_t)0x8800 * multiplier) >> shift;
+    if (microvolts > limit) {
+        microvolts = limit;
+    } else if (microvolts < -limit) {
+        microvolts = -limit;
+    }
+
+    int32_t scaled = microvolts * ((int32_t)1 << shift);
+    int32_t half = multiplier / 2;
+    int32_t rawValue = (scaled >= 0 ? scaled + half : scaled - half) / multiplier;
+    return rawValue > 32767 ? 32767 : (rawValue < -32768 ? -32768 : (int16_t)rawValue);
+}
+
+byte Ads1115Plus::muxIndex(MuxConfig mux) {
+    return ((uint16_t)mux >> 12) & 0x7;
+}
+
+byte Ads1115Plus::gainIndex(AdsGain gain) {
+    byte index = ((uint16_t)gain >> 9) & 0x7;
+
+    // Bits 11:9 values 110 and 111 are also gain 16 (see datasheet table 8)
+    return index < ADS_GAIN_COUNT ? index : ADS_GAIN_COUNT - 1;
+}
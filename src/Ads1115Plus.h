@@ -1,6 +1,15 @@
 #ifndef __ADS1115_PLUS_H__
 #define __ADS1115_PLUS_H__
 
+#if defined(__linux__) && !defined(ARDUINO)
+
+/// Builds the driver on Linux, talking to /dev/i2c-N (i2c-dev) instead of Wire
+#define ADS1115PLUS_LINUX_I2C
+#include "AdsLinuxPlatform.h"
+#include "AdsLinuxI2c.h"
+
+#else
+
 #if ARDUINO >= 100
 #include "Arduino.h"
 #else
@@ -9,10 +18,41 @@
 
 #include <Wire.h>
 
+#endif
+
+/*
+ * Compile time trimming: defining these before the library is built (PlatformIO build_flags, or the
+ * compiler.cpp.extra_flags build property of arduino-cli) removes parts of the Ads1115Plus API
+ * - ADS1115PLUS_NO_LEGACY_API: the Adafruit ADS1x15 compatible methods (readADC_singleEnded, readADC_Differential_0_1, ...)
+ * - ADS1115PLUS_NO_DIFFERENTIAL_HELPERS: the per channel pair variants (readDifferentialRaw01, startComparatorMode01, ...),
+ *   the OnMux methods cover them
+ * - ADS1115PLUS_NO_FLOAT: the millivolt (double) methods, the microvolt ones use integer arithmetic only
+ * The linker already drops the methods a sketch doesn't call (-ffunction-sections and --gc-sections are the default),
+ * these make sure nothing pulls them back in (e.g. the float library from a leftover millivolt call) and shorten the
+ * compile. See extras/SizeReport for the flash used by each configuration
+ */
+
 
 /// The default raw difference for the low threshold, when not specified in continous conversion mode (startComparatorMode_SingleEnded)
 #define DEFAULT_LOW_THRESHOLD_DIFF 5
 
+/// The value of the config register after power-up or a general call reset (see datasheet table 8)
+#define ADS_CONFIG_RESET_VALUE 0x8583
+
+/// The number of mux configurations (see MuxConfig)
+#define ADS_MUX_COUNT 8
+
+/// The number of gain configurations (see AdsGain)
+#define ADS_GAIN_COUNT 6
+
+/// The typical supply current while converting in nanoamps (datasheet 7.5, 150uA)
+#define ADS_ACTIVE_CURRENT_NANOAMPS 150000
+
+/// The typical supply current when powered down in nanoamps (datasheet 7.5, 0.5uA)
+#define ADS_POWER_DOWN_CURRENT_NANOAMPS 500
+
+class AdsCalibration;
+
 /** Enumerates the addresses available for the ADS */
 enum class AdsAddress: byte {
 
@@ -190,6 +230,25 @@ enum class MuxConfig : uint16_t {
     channel3 = (uint16_t)0x7 << 12
 };
 
+/** A conversion result along with what's needed to interpret it (see Ads1115Plus::readSampleOnMux) */
+struct AdsSample {
+
+    /// The index of the device on its i2c bus (address - AdsAddress::gnd)
+    byte device;
+
+    /// The channel (single or differential) the value was read on
+    MuxConfig mux;
+
+    /// The gain used for the conversion
+    AdsGain gain;
+
+    /// The micros() when the conversion result was read (AdsScanner uses the micros() when the conversion was started)
+    uint32_t timestampMicros;
+
+    /// The raw conversion result
+    int16_t raw;
+};
+
 
 /**
  * Class used to interface with the ADS1115
@@ -244,6 +303,24 @@ private:
     /// The queue and disable bits
     uint16_t comparatorAssertConfig;
 
+    /// The offset and gain correction applied by the microvolts methods (nullptr when uncorrected)
+    const AdsCalibration *calibration;
+
+    /// The values last written to the config (bit 15 cleared), low threshold and high threshold registers, indexed by AddressPointerReg
+    uint16_t registerShadows[4];
+
+    /// Bit n is set when registerShadows[n] is known to match the device register
+    byte validShadows;
+
+    /// The intended high threshold in microvolts (used when [thresholdsInMicrovolts])
+    int32_t highThresholdMicrovolts;
+
+    /// The intended low threshold in microvolts (used when [thresholdsInMicrovolts])
+    int32_t lowThresholdMicrovolts;
+
+    /// Whether the thresholds were given in microvolts, then they follow the gain, mux and calibration of the config
+    bool thresholdsInMicrovolts;
+
     /** The posible configurations for the OS config bit (bit 15) */
     enum class OsConfig: uint16_t {
         noEffect = 0x0, // write
@@ -297,11 +374,31 @@ private:
     /** Writes the [currentConfigRegister] to the ads */ 
     void writeCurrentConfig();
 
+    /// Writes the given [value] to the register [reg] and updates its shadow
+    void writeRegister(AddressPointerReg reg, uint16_t value);
+
+    /**
+     * Writes the given [value] to the register [reg], unless its shadow shows the device already holds it
+     * @return true if the register was written
+     */
+    bool writeRegisterIfChanged(AddressPointerReg reg, uint16_t value);
+
+    /// Writes the raw thresholds, skipping the ones the device already holds, returns the number of registers written
+    byte writeThresholds(int16_t highThreshold, int16_t lowThreshold);
+
+    /**
+     * Converts the microvolt thresholds for the current gain, mux and calibration and writes the ones that changed
+     * Called before the config is written, does nothing when the thresholds are raw or the comparator is disabled
+     */
+    void updateMicrovoltThresholds();
+
+#if !defined(ADS1115PLUS_LINUX_I2C)
     /// Reads a byte using a legacy supported implementation of i2c
     static byte i2cReadByte();
 
     /// Writes the given [value] through i2c (its legacy supported)
     static void i2cWriteByte(byte value);
+#endif
 
     /**
      * Writes the given [value] to the Ads
@@ -319,6 +416,15 @@ private:
      */
     static uint16_t readFromAds(byte i2cAddress, byte reg);
 
+    /**
+     * Same as readFromAds, but reports whether the Ads acknowledged the transfer
+     * @param i2cAddress The address of the Ads from which the data will be read
+     * @param reg The [AddressPointer] register from which data will be read
+     * @param value Set to the two bytes read from the Ads (only valid when true is returned)
+     * @return true if the Ads acknowledged the pointer write and returned both bytes
+     */
+    static bool tryReadFromAds(byte i2cAddress, byte reg, uint16_t &value);
+
 public:
 
     /**
@@ -335,13 +441,48 @@ public:
      */
     void begin();
 
+#if defined(ADS1115PLUS_LINUX_I2C)
+    /**
+     * Opens the given i2c-dev [i2cDevice] (e.g. "/dev/i2c-1"), used by every instance
+     * begin() opens ADS_LINUX_DEFAULT_I2C_DEVICE when no bus has been opened yet
+     * @return false if the device couldn't be opened
+     */
+    bool begin(const char *i2cDevice);
+#endif
+
+    /// Returns the i2c address currently used by this instance
+    AdsAddress getAddress();
+
+    // MARK: Device detection
+
+    /**
+     * Checks whether any device acknowledges the given [address] (an empty i2c transaction)
+     * This is cheap enough to be called periodically to detect boards being removed
+     */
+    static bool isResponding(AdsAddress address);
+
+    /**
+     * Checks whether the device on the given [address] is an ADS1115 that hasn't been configured yet
+     * The config register is compared against its reset value [ADS_CONFIG_RESET_VALUE]
+     * Note a device left in continous conversion mode (e.g. after a MCU reset) won't match, see sendGeneralCallReset()
+     */
+    static bool isUnconfiguredAds1115(AdsAddress address);
+
+    /**
+     * Sends the i2c general call reset (address 0x00, command 0x06)
+     * Every ADS1115 on the bus reloads its reset config, note other devices that support the general call will reset too
+     */
+    static void sendGeneralCallReset();
+
     // MARK: Channel reading
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
     /** 
      * Same as calling readChannelBits(channel)
      * @deprecated use readChannelBits(channel) instead
      */
     uint16_t readADC_singleEnded(byte channel);
+#endif
 
     /**
      * Reads the given [channel] from the ADS1115 with the current gain
@@ -350,13 +491,16 @@ public:
      */
     uint16_t readChannelRaw(byte channel);
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
     /**
      * Reads the given [channel] from the ADS1115 with the current gain
      * @param channel The channel to be read from the ads (0 to 3)
      * @return the value of the given [channel] in millivolts
      */
     double readChannelMillivolts(byte channel);
+#endif
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
     /** 
      * Reads the ADS1115 in differetial mode between channels 0 and 1 
      * @deprecated use readDifferentialRaws01 instead
@@ -370,7 +514,9 @@ public:
      * @return (ADS channel 2 - ADS channel 3) * gain
      */
     int16_t readADC_Differential_2_3();
+#endif
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
     /**
      * Reads the ADS1115 in differential mode between channels 0 and 1
      * @return (ADS channel 0 - ADS channel 1) * gain (raw value)
@@ -394,7 +540,9 @@ public:
      * @return (ADS channel 2 - ADS channel 3) * gain (raw value)
      */
     int16_t readDifferentialRaw23();
+#endif
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS) && !defined(ADS1115PLUS_NO_FLOAT)
     /**
      * Reads the ADS1115 in differential mode between channels 0 and 1
      * @return (ADS channel 0 - ADS channel 1) * gain (in millivolts)
@@ -418,6 +566,7 @@ public:
      * @return (ADS channel 2 - ADS channel 3) * gain (in millivolts)
      */
     double readDifferentialMillivolts23();
+#endif
 
     /**
      * Performs a single shot reading on the given [mux] channel 
@@ -427,6 +576,7 @@ public:
      */
     int16_t readRawOnMux(MuxConfig mux);
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
     /**
      * Performs a single shot reading on the given [mux] channel
      * Note the value can only be negative when reading a differential channel
@@ -435,9 +585,39 @@ public:
      * @return The value read from the ADS in millivolts
      */
     double readMillivoltsOnMux(MuxConfig mux);
+#endif
+
+    /**
+     * Performs a single shot reading on the given [mux] channel
+     * @param mux The channel (single or differential) to be read from the ADS
+     * @return The raw value along with the device, mux, gain and time it was read
+     */
+    AdsSample readSampleOnMux(MuxConfig mux);
+
+    // MARK: Non-blocking reading
+
+    /**
+     * Starts a single shot conversion on the given [mux] channel and returns without waiting
+     * Read the result with getLastConversionResults() once conversionTimeMicros() have elapsed (or isConversionReady() is true)
+     * @param mux The channel (single or differential) to be read from the ADS
+     */
+    void startSingleShotOnMux(MuxConfig mux);
+
+    /// Returns true when no conversion is being performed (reads the OS bit of the config register)
+    bool isConversionReady();
+
+    /**
+     * Returns the time in microseconds a single shot conversion takes with the current sample speed
+     * Includes the 10% tolerance of the data rate and the wake up from power down
+     */
+    unsigned long conversionTimeMicros();
+
+    /// Returns the time in microseconds a single shot conversion takes with the given [speed]
+    static unsigned long conversionTimeMicros(AdsSampleSpeed speed);
 
     // MARK: Comparator mode
 
+#if !defined(ADS1115PLUS_NO_LEGACY_API)
     /**
      * Starts the comparator mode using the given [channel], with the given raw [highThreshold] and raw [lowThreshold]; using the following defaults
      * - Low threshold: highThreshold - [DEFAULT_LOW_THRESHOLD_DIFF]
@@ -448,6 +628,7 @@ public:
      * @deprecated use startContinousConversionMode instead
      */
     void startComparator_SingleEnded(byte channel, uint16_t highThreshold, ComparatorLatchingConfig comparatorLatching = ComparatorLatchingConfig::nonLatching, ComparatorModeConfig comparatorMode = ComparatorModeConfig::traditionalComparator, ComparatorPolarityConfig comparatorPolarity = ComparatorPolarityConfig::activeLow, ComparatorAssertConfig comparatorQueue = ComparatorAssertConfig::assertAfterOne);
+#endif
 
     /**
      * Starts the comparator mode using the given [mux], with the given raw [highThreshold] and raw [lowThreshold]; using the following defaults
@@ -458,6 +639,15 @@ public:
      */
     void startComparatorModeOnMux(MuxConfig mux, uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching = ComparatorLatchingConfig::nonLatching, ComparatorModeConfig comparatorMode = ComparatorModeConfig::traditionalComparator, ComparatorPolarityConfig comparatorPolarity = ComparatorPolarityConfig::activeLow, ComparatorAssertConfig comparatorQueue = ComparatorAssertConfig::assertAfterOne);
 
+    /**
+     * Starts the comparator mode using the given [mux], with thresholds in microvolts (see setThresholdsMicrovolts()); using the following defaults
+     * - Comparator latching: false
+     * - Comparator mode: traditional comparator
+     * - Comparator polarity: active low
+     * - Comparator queue: assert after 1 conversion
+     */
+    void startComparatorModeMicrovolts(MuxConfig mux, int32_t highMicrovolts, int32_t lowMicrovolts, ComparatorLatchingConfig comparatorLatching = ComparatorLatchingConfig::nonLatching, ComparatorModeConfig comparatorMode = ComparatorModeConfig::traditionalComparator, ComparatorPolarityConfig comparatorPolarity = ComparatorPolarityConfig::activeLow, ComparatorAssertConfig comparatorQueue = ComparatorAssertConfig::assertAfterOne);
+
     /** 
      * Starts the comparator mode using the given [channel], with the given raw [highThreshold] and raw [lowThreshold]; using the following defaults
      * - Comparator latching: false
@@ -467,6 +657,7 @@ public:
      */
     void startComparatorMode(byte channel, uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching = ComparatorLatchingConfig::nonLatching, ComparatorModeConfig comparatorMode = ComparatorModeConfig::traditionalComparator, ComparatorPolarityConfig comparatorPolarity = ComparatorPolarityConfig::activeLow, ComparatorAssertConfig comparatorQueue = ComparatorAssertConfig::assertAfterOne);
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
     /**
      * Starts the comparator mode for differential channel 0-1, with the given raw [highThreshold] and raw [lowThreshold]; using the following defaults
      * - Comparator latching: false
@@ -502,6 +693,7 @@ public:
      * - Comparator queue: assert after 1 conversion
      */
     void startComparatorMode23(uint16_t highThreshold, uint16_t lowThreshold, ComparatorLatchingConfig comparatorLatching = ComparatorLatchingConfig::nonLatching, ComparatorModeConfig comparatorMode = ComparatorModeConfig::traditionalComparator, ComparatorPolarityConfig comparatorPolarity = ComparatorPolarityConfig::activeLow, ComparatorAssertConfig comparatorQueue = ComparatorAssertConfig::assertAfterOne);
+#endif
 
     /**
      * Starts the continous conversion mode on the given channel
@@ -511,6 +703,7 @@ public:
     void startContinousConversionMode(byte channel);
 
 
+#if !defined(ADS1115PLUS_NO_DIFFERENTIAL_HELPERS)
     /**
      * Starts the continous conversion mode on differential channel 0 - 1
      * This method disables the comparator assert
@@ -534,6 +727,7 @@ public:
      * This method disables the comparator assert
      */
     void startContinousConversionMode23();
+#endif
 
     /**
      * Starts the continous conversion mode on the given mux channel
@@ -541,6 +735,13 @@ public:
      * @param mux the mux channel for which the continuous conversion mode should begin (0, 1, 2, 3, 01, 03, 13 or 23)
      */
     void startContinousConversionModeOnMux(MuxConfig mux);
+
+    /**
+     * Starts the continous conversion mode on the given mux channel, with the ALRT pin as a conversion ready signal
+     * The pin pulses (for about 8us) at the end of each conversion, use it to read every conversion exactly once
+     * This uses the threshold registers (high MSB set, low MSB cleared), so the comparator isn't available meanwhile
+     */
+    void startConversionReadyModeOnMux(MuxConfig mux);
     
 
     /** 
@@ -549,11 +750,19 @@ public:
      */
     int16_t getLastConversionResults();
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
     /** 
      * Returns the result of the last conversion in millivolts (using the last configured gain) 
      * Note that the value may be negative if the continous conversion has been set in a differential channel
      */
     double getLastConversionMillivolts();
+#endif
+
+    /** 
+     * Returns the last conversion along with the device, mux, gain and time it was read (use this when using continuous conversion mode)
+     * Note the mux and gain are the ones last configured
+     */
+    AdsSample getLastConversionSample();
 
     // MARK: Comparator getter and setters
 
@@ -625,8 +834,21 @@ public:
     /// Returns the sample speed currently used for readings
     AdsSampleSpeed getSampleSpeed();
 
+    /**
+     * Sets the mux (single or differential channel) of the current config
+     * @param updateConfig if true updates the ADS configuration when running in continous conversion mode (true by default)
+     */
+    void setMux(MuxConfig mux, bool updateConfig = true);
+
+    /// Returns the mux (single or differential channel) of the current config
+    MuxConfig getMux();
+
+    /// Returns the nominal time between two conversions in continous conversion mode for the given [speed] (1 / data rate)
+    static unsigned long samplePeriodMicros(AdsSampleSpeed speed);
+
     // MARK: Utility methods
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
     /**
      * The millivolts / bit for the current gain config (used to determine the voltage)
      * Note this is also known as the device resolution for the current gain config
@@ -641,10 +863,12 @@ public:
      * @returns mv / rawValue factor
      */
     double millivoltsPerRawValue(AdsGain gain);
+#endif
 
     /** Returns the delay in ms, for the current single shot channel reading */
     unsigned long delayForChannelReading();
 
+#if !defined(ADS1115PLUS_NO_FLOAT)
     /// Transforms the given [rawValue] into millivolts using the current gain config
     double rawValueToMillivolts(int16_t rawValue);
 
@@ -656,6 +880,127 @@ public:
 
     /// Transforms the given millivolts into a raw ADS value, using the given [gain] (note the result is rounded to the nearest int)
     double millivoltsToRawValue(double millivolts, AdsGain gain);
+#endif
+
+    // MARK: Integer conversion (microvolts)
+
+    /**
+     * Sets the offset and gain correction used by the microvolts methods
+     * The [calibration] isn't copied, it has to outlive this instance (or be replaced with nullptr)
+     * @param calibration The correction tables of this device, nullptr to use the ideal datasheet LSB sizes
+     */
+    void setCalibration(const AdsCalibration *calibration);
+
+    /// Returns the correction tables currently used (nullptr if none)
+    const AdsCalibration *getCalibration();
+
+    /**
+     * Transforms the given [rawValue] into microvolts using the current mux and gain config
+     * Only integer arithmetic is used (a multiplication and a shift), the calibration is applied if one is set
+     */
+    int32_t rawValueToMicrovolts(int16_t rawValue);
+
+    /// Transforms the given [rawValue] read on [mux] with [gain] into microvolts (applies the calibration if one is set)
+    int32_t rawValueToMicrovolts(int16_t rawValue, MuxConfig mux, AdsGain gain);
+
+    /// Transforms the given [microvolts] into the raw value read with the current mux and gain (rounded, clamped to the int16 range)
+    int16_t microvoltsToRawValue(int32_t microvolts);
+
+    /// Transforms the given [microvolts] into the raw value read on [mux] with [gain] (applies the calibration if one is set)
+    int16_t microvoltsToRawValue(int32_t microvolts, MuxConfig mux, AdsGain gain);
+
+    /**
+     * Performs a single shot reading on the given [mux] channel
+     * @return The value read from the ADS in microvolts (corrected if a calibration is set)
+     */
+    int32_t readMicrovoltsOnMux(MuxConfig mux);
+
+    /**
+     * Reads the given [channel] from the ADS1115 with the current gain
+     * @param channel The channel to be read from the ads (0 to 3)
+     * @return the value of the given [channel] in microvolts (corrected if a calibration is set)
+     */
+    int32_t readChannelMicrovolts(byte channel);
+
+    /// Returns the result of the last conversion in microvolts (corrected if a calibration is set)
+    int32_t getLastConversionMicrovolts();
+
+    /**
+     * The ideal microvolts / bit for the given [gain] as a fixed point value
+     * microvolts = (rawValue * microvoltsMultiplier(gain)) >> microvoltsShift(gain)
+     * The multiplier is kept below 2^15 so the product fits an int32
+     */
+    static uint16_t microvoltsMultiplier(AdsGain gain);
+
+    /// The shift used with microvoltsMultiplier(gain)
+    static byte microvoltsShift(AdsGain gain);
+
+    /**
+     * Reverts the fixed point conversion: rawValue = microvolts * 2^shift / multiplier, rounded to the nearest
+     * Only int32 math is used, values beyond the full scale are clamped to the int16 range
+     */
+    static int16_t fixedPointToRawValue(int32_t microvolts, uint16_t multiplier, byte shift);
+
+    // MARK: Register shadows
+    // Only setThresholds(), setThresholdsMicrovolts() and writeConfigIfChanged() skip writes, the start...() calls always
+    // write their registers
+
+    /**
+     * Records that the device holds its reset values (after power-up or sendGeneralCallReset())
+     * The registers left at their reset values are then skipped by setThresholds() and writeConfigIfChanged()
+     */
+    void assumeResetState();
+
+    /// Forgets the register values known, the next writes are always performed (e.g. after another instance used the device)
+    void forgetRegisterState();
+
+    /**
+     * Sets the [mux] and the conversion mode of the config without writing it (see writeConfigIfChanged())
+     * @param continuousConversion true for continuous conversions, false for single shot
+     */
+    void setMuxAndMode(MuxConfig mux, bool continuousConversion);
+
+    /**
+     * Writes the raw [highThreshold] and [lowThreshold] used by the comparator, skipping the ones the device already holds
+     * Raw thresholds stay as given when the gain changes (see setThresholdsMicrovolts())
+     * @return The number of registers written (0 to 2)
+     */
+    byte setThresholds(int16_t highThreshold, int16_t lowThreshold);
+
+    /**
+     * Sets the comparator thresholds in microvolts
+     * The raw registers are computed for the current gain, mux and calibration (integer math), and computed again whenever
+     * the config is written with the comparator enabled, so the thresholds keep their voltage when the gain changes.
+     * Only the registers whose value changes are written
+     * @return The number of registers written (0 to 2)
+     */
+    byte setThresholdsMicrovolts(int32_t highMicrovolts, int32_t lowMicrovolts);
+
+    /// Returns the intended high threshold in microvolts (the raw threshold converted when it was set as raw)
+    int32_t getHighThresholdMicrovolts();
+
+    /// Returns the intended low threshold in microvolts (the raw threshold converted when it was set as raw)
+    int32_t getLowThresholdMicrovolts();
+
+    /**
+     * Writes the current config (mux, gain, speed, mode and comparator) unless the device already holds it
+     * Unlike the reading methods this doesn't start a single shot conversion
+     * @return true if the config register was written
+     */
+    bool writeConfigIfChanged();
+
+    /**
+     * Reads back the registers whose value is known and compares them with what was written
+     * The registers that don't match are forgotten (so they will be written again)
+     * @return true if every known register matches (and the device answered)
+     */
+    bool verifyRegisters();
+
+    /// Returns the index (0 to 7) of the given [mux], used by per-mux tables
+    static byte muxIndex(MuxConfig mux);
+
+    /// Returns the index (0 to 5) of the given [gain], used by per-gain tables
+    static byte gainIndex(AdsGain gain);
 };
 
 
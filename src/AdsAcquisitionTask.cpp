@@ -0,0 +1,228 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsAcquisitionTask.h"
+
+#if defined(ADS_ACQUISITION_STD_THREAD)
+#include <chrono>
+#endif
+
+/// Set in AdsSampleBoard packed words once a sample has been published
+#define ADS_BOARD_VALID_BIT ((uint32_t)1 << 24)
+
+
+AdsSampleBoard::AdsSampleBoard() {
+    for (byte i = 0; i < ADS_BOARD_CHANNELS; i++) {
+        channels[i].sequence = 0;
+        channels[i].packed = 0;
+        channels[i].timestampMicros = 0;
+    }
+}
+
+void AdsSampleBoard::publish(const AdsSample &sample) {
+    Channel &channel = channels[channelOf(sample.device, sample.mux)];
+    uint32_t packed = (uint16_t)sample.raw
+        | ((uint32_t)(sample.device & 0x3) << 16)
+        | ((uint32_t)Ads1115Plus::muxIndex(sample.mux) << 18)
+        | ((uint32_t)Ads1115Plus::gainIndex(sample.gain) << 21)
+        | ADS_BOARD_VALID_BIT;
+
+    // Odd sequence while writing, the release fence keeps the sample writes after it
+    uint32_t sequence = __atomic_load_n(&channel.sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&channel.sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_store_n(&channel.packed, packed, __ATOMIC_RELAXED);
+    __atomic_store_n(&channel.timestampMicros, sample.timestampMicros, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&channel.sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+bool AdsSampleBoard::read(byte device, MuxConfig mux, AdsSample &sample) {
+    Channel &channel = channels[channelOf(device, mux)];
+
+    for (byte attempt = 0; attempt < ADS_BOARD_READ_RETRIES; attempt++) {
+        uint32_t sequenceBefore = __atomic_load_n(&channel.sequence, __ATOMIC_ACQUIRE);
+        if (sequenceBefore & 1) {
+            continue; // Being written
+        }
+
+        uint32_t packed = __atomic_load_n(&channel.packed, __ATOMIC_RELAXED);
+        uint32_t timestamp = __atomic_load_n(&channel.timestampMicros, __ATOMIC_RELAXED);
+
+        // The acquire fence keeps the sample reads before the second sequence read
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&channel.sequence, __ATOMIC_RELAXED) != sequenceBefore) {
+            continue; // Written meanwhile
+        }
+
+        if ((packed & ADS_BOARD_VALID_BIT) == 0) {
+            return false;
+        }
+        sample.raw = (int16_t)(packed & 0xFFFF);
+        sample.device = (packed >> 16) & 0x3;
+        sample.mux = (MuxConfig)(((packed >> 18) & 0x7) << 12);
+        sample.gain = (AdsGain)(((packed >> 21) & 0x7) << 9);
+        sample.timestampMicros = timestamp;
+        return true;
+    }
+    return false;
+}
+
+bool AdsSampleBoard::read(AdsAddress address, MuxConfig mux, AdsSample &sample) {
+    return read((byte)address - (byte)AdsAddress::gnd, mux, sample);
+}
+
+uint32_t AdsSampleBoard::sequenceOf(byte device, MuxConfig mux) {
+    return __atomic_load_n(&channels[channelOf(device, mux)].sequence, __ATOMIC_ACQUIRE);
+}
+
+byte AdsSampleBoard::channelOf(byte device, MuxConfig mux) {
+    return ((device & 0x3) << 3) | Ads1115Plus::muxIndex(mux);
+}
+
+// MARK: Acquisition task
+
+AdsAcquisitionTask::AdsAcquisitionTask(AdsSampleBoard &board) : board(board) {
+    scannerCount = 0;
+    publishedSamples = 0;
+    running = false;
+#if defined(ADS_ACQUISITION_FREERTOS)
+    taskHandle = nullptr;
+    stopped = true;
+#endif
+}
+
+AdsAcquisitionTask::~AdsAcquisitionTask() {
+#if defined(ADS_ACQUISITION_FREERTOS) || defined(ADS_ACQUISITION_STD_THREAD)
+    end();
+#endif
+}
+
+bool AdsAcquisitionTask::addScanner(AdsScanner &scanner) {
+    if (scannerCount >= ADS_MAX_ACQUISITION_SCANNERS) {
+        return false;
+    }
+    scanner.setSampleCallback(publishSample, this);
+    scanners[scannerCount++] = &scanner;
+    return true;
+}
+
+bool AdsAcquisitionTask::runOnce() {
+    bool published = false;
+    for (byte i = 0; i < scannerCount; i++) {
+        published = scanners[i]->poll() || published;
+    }
+    return published;
+}
+
+uint32_t AdsAcquisitionTask::getPublishedSamples() {
+    return __atomic_load_n(&publishedSamples, __ATOMIC_RELAXED);
+}
+
+#if defined(ADS_ACQUISITION_FREERTOS)
+
+bool AdsAcquisitionTask::begin(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    if (taskHandle != nullptr) {
+        return false;
+    }
+    __atomic_store_n(&running, true, __ATOMIC_RELEASE);
+    __atomic_store_n(&stopped, false, __ATOMIC_RELEASE);
+    if (xTaskCreatePinnedToCore(taskEntry, "ads", stackSize, this, priority, &taskHandle, core) != pdPASS) {
+        taskHandle = nullptr;
+        __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+        __atomic_store_n(&stopped, true, __ATOMIC_RELEASE);
+        return false;
+    }
+    return true;
+}
+
+void AdsAcquisitionTask::end() {
+    if (taskHandle == nullptr) {
+        return;
+    }
+    __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+    while (!__atomic_load_n(&stopped, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(1);
+    }
+    taskHandle = nullptr;
+}
+
+void AdsAcquisitionTask::taskEntry(void *task) {
+    AdsAcquisitionTask *acquisitionTask = (AdsAcquisitionTask *)task;
+    acquisitionTask->run();
+    __atomic_store_n(&acquisitionTask->stopped, true, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+#elif defined(ADS_ACQUISITION_STD_THREAD)
+
+bool AdsAcquisitionTask::begin() {
+    if (thread.joinable()) {
+        return false;
+    }
+    __atomic_store_n(&running, true, __ATOMIC_RELEASE);
+    thread = std::thread(&AdsAcquisitionTask::run, this);
+    return true;
+}
+
+void AdsAcquisitionTask::end() {
+    if (!thread.joinable()) {
+        return;
+    }
+    __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+    thread.join();
+}
+
+#endif
+
+// MARK: Private methods
+
+void AdsAcquisitionTask::run() {
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        runOnce();
+
+        // Sleep until the next conversion has to be started or read (capped so end() is noticed)
+        uint32_t wait = microsUntilNextEvent();
+        if (wait > 10000) {
+            wait = 10000;
+        }
+#if defined(ADS_ACQUISITION_FREERTOS)
+        // Always block for at least a tick: yielding alone would starve the lower priority tasks (idle included)
+        TickType_t ticks = pdMS_TO_TICKS(wait / 1000);
+        vTaskDelay(ticks > 1 ? ticks - 1 : 1);
+#elif defined(ADS_ACQUISITION_STD_THREAD)
+        if (wait > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(wait));
+        }
+#endif
+    }
+}
+
+uint32_t AdsAcquisitionTask::microsUntilNextEvent() {
+    uint32_t shortest = 0xFFFFFFFF;
+    for (byte i = 0; i < scannerCount; i++) {
+        uint32_t wait = scanners[i]->microsUntilNextEvent();
+        if (wait < shortest) {
+            shortest = wait;
+        }
+    }
+    return shortest;
+}
+
+void AdsAcquisitionTask::publishSample(const AdsSample &sample, void *task) {
+    AdsAcquisitionTask *acquisitionTask = (AdsAcquisitionTask *)task;
+    acquisitionTask->board.publish(sample);
+    __atomic_store_n(&acquisitionTask->publishedSamples, acquisitionTask->publishedSamples + 1, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,177 @@
+#ifndef __ADS_ACQUISITION_TASK_H__
+#define __ADS_ACQUISITION_TASK_H__
+
+#include "Ads1115Plus.h"
+#include "AdsScanner.h"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define ADS_ACQUISITION_FREERTOS
+#elif !defined(ARDUINO)
+#include <thread>
+#define ADS_ACQUISITION_STD_THREAD
+#endif
+
+/// The number of channels of an AdsSampleBoard (4 devices * 8 mux configs)
+#define ADS_BOARD_CHANNELS 32
+
+/// The maximum number of scanners (one per device) run by an AdsAcquisitionTask
+#define ADS_MAX_ACQUISITION_SCANNERS 4
+
+/// The number of times AdsSampleBoard::read() retries when the sample is being written
+#define ADS_BOARD_READ_RETRIES 16
+
+/**
+ * The latest sample of each channel (device and mux), written by a single task and read by any number of tasks
+ *
+ * Each channel is protected by a sequence lock: the writer makes the sequence odd while it writes the sample and
+ * even again once done, readers copy the sample and retry if the sequence changed meanwhile.
+ * Readers never block the writer nor each other, no mutex is involved.
+ */
+class AdsSampleBoard {
+
+private:
+
+    /** A published sample, packed in two words so each word is read / written at once */
+    struct Channel {
+
+        /// Odd while the sample is being written
+        uint32_t sequence;
+
+        /// raw (bits 15:0), device (bits 17:16), mux index (bits 20:18), gain index (bits 23:21), valid (bit 24)
+        uint32_t packed;
+
+        /// The timestamp of the sample
+        uint32_t timestampMicros;
+    };
+
+    /// The samples indexed by channelOf(device, mux)
+    Channel channels[ADS_BOARD_CHANNELS];
+
+    /// Returns the channel index of the given [device] (0 to 3) and [mux]
+    static byte channelOf(byte device, MuxConfig mux);
+
+public:
+
+    /// Creates a board with no samples
+    AdsSampleBoard();
+
+    /// Publishes the given [sample] (only one task may publish)
+    void publish(const AdsSample &sample);
+
+    /**
+     * Copies the latest sample of the given channel, never blocks
+     * @param device The index of the device on its bus (address - AdsAddress::gnd)
+     * @param sample Set to the latest sample when true is returned
+     * @return false if no sample has been published for the channel (or it kept changing during ADS_BOARD_READ_RETRIES attempts)
+     */
+    bool read(byte device, MuxConfig mux, AdsSample &sample);
+
+    /// Same as read(), using the index of the given [address]
+    bool read(AdsAddress address, MuxConfig mux, AdsSample &sample);
+
+    /// Returns the sequence of the given channel, it changes by 2 each time a sample is published (useful to detect new samples)
+    uint32_t sequenceOf(byte device, MuxConfig mux);
+};
+
+/**
+ * Owns the i2c bus and the devices: polls one AdsScanner per device and publishes every sample to an AdsSampleBoard
+ * Other tasks read the latest samples from the board and must not use the devices or the bus
+ *
+ * - On ESP32 begin() starts a FreeRTOS task (pinned to a core)
+ * - On the host (Linux builds) begin() starts a std::thread
+ * - On single core boards call runOnce() from loop() instead
+ */
+class AdsAcquisitionTask {
+
+private:
+
+    /// The scanners polled
+    AdsScanner *scanners[ADS_MAX_ACQUISITION_SCANNERS];
+
+    /// The number of scanners polled
+    byte scannerCount;
+
+    /// Receives the samples
+    AdsSampleBoard &board;
+
+    /// The number of samples published
+    uint32_t publishedSamples;
+
+    /// True while the task / thread should keep running
+    bool running;
+
+#if defined(ADS_ACQUISITION_FREERTOS)
+    /// The FreeRTOS task, nullptr when not started
+    TaskHandle_t taskHandle;
+
+    /// True once the task has left its loop
+    bool stopped;
+
+    /// The entry point of the FreeRTOS task
+    static void taskEntry(void *task);
+#elif defined(ADS_ACQUISITION_STD_THREAD)
+    /// The acquisition thread
+    std::thread thread;
+#endif
+
+    /// Polls the scanners until end() is called, sleeping until the next event
+    void run();
+
+    /// Returns the time in microseconds until a scanner has something to do
+    uint32_t microsUntilNextEvent();
+
+    /// Scanner callback publishing the [sample] to the board of [task]
+    static void publishSample(const AdsSample &sample, void *task);
+
+public:
+
+    /// Creates a task publishing to the given [board]
+    AdsAcquisitionTask(AdsSampleBoard &board);
+
+    /// Stops the task
+    ~AdsAcquisitionTask();
+
+    /**
+     * Adds a scanner (call before begin(), the scanner has to be started by the caller)
+     * The sample callback of the scanner is replaced
+     * @return false if there are already ADS_MAX_ACQUISITION_SCANNERS scanners
+     */
+    bool addScanner(AdsScanner &scanner);
+
+    /**
+     * Polls every scanner once
+     * @return true if any sample was published
+     */
+    bool runOnce();
+
+#if defined(ADS_ACQUISITION_FREERTOS)
+    /**
+     * Starts the acquisition task
+     * The task blocks for at least a tick between polls, so the scanners are polled with a resolution of one tick
+     * (1ms with the Arduino ESP32 core): keep the scanner periods a few ticks long
+     * @param stackSize The stack of the task in bytes
+     * @param priority The FreeRTOS priority of the task (just above loop(), below the WiFi / BT tasks)
+     * @param core The core the task is pinned to (0, away from loop() which runs on core 1)
+     * @return false if the task couldn't be created (or is already running)
+     */
+    bool begin(uint32_t stackSize = 4096, UBaseType_t priority = 2, BaseType_t core = 0);
+#elif defined(ADS_ACQUISITION_STD_THREAD)
+    /**
+     * Starts the acquisition thread
+     * @return false if it is already running
+     */
+    bool begin();
+#endif
+
+#if defined(ADS_ACQUISITION_FREERTOS) || defined(ADS_ACQUISITION_STD_THREAD)
+    /// Stops the acquisition task and waits for it to finish
+    void end();
+#endif
+
+    /// Returns the number of samples published
+    uint32_t getPublishedSamples();
+};
+
+#endif
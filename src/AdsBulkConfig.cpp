@@ -0,0 +1,136 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsBulkConfig.h"
+
+
+bool AdsBulkResult::succeeded() const {
+    return failedDevices == 0;
+}
+
+AdsBulkConfig::AdsBulkConfig() {
+    setupCount = 0;
+}
+
+AdsDeviceSetup *AdsBulkConfig::add(Ads1115Plus &ads, AdsDeviceMode mode, MuxConfig mux) {
+    if (setupCount >= ADS_BULK_MAX_DEVICES) {
+        return nullptr;
+    }
+
+    AdsDeviceSetup &setup = setups[setupCount++];
+    setup.ads = &ads;
+    setup.mode = mode;
+    setup.mux = mux;
+    setup.gain = ads.getGain();
+    setup.speed = ads.getSampleSpeed();
+    setup.highThreshold = 0x7FFF;
+    setup.lowThreshold = (int16_t)0x8000;
+    setup.comparatorMode = ComparatorModeConfig::traditionalComparator;
+    setup.comparatorPolarity = ComparatorPolarityConfig::activeLow;
+    setup.comparatorLatching = ComparatorLatchingConfig::nonLatching;
+    setup.comparatorQueue = ComparatorAssertConfig::assertAfterOne;
+    return &setup;
+}
+
+AdsDeviceSetup *AdsBulkConfig::addComparator(Ads1115Plus &ads, MuxConfig mux, int16_t highThreshold, int16_t lowThreshold) {
+    AdsDeviceSetup *setup = add(ads, AdsDeviceMode::comparator, mux);
+    if (setup != nullptr) {
+        setup->highThreshold = highThreshold;
+        setup->lowThreshold = lowThreshold;
+    }
+    return setup;
+}
+
+void AdsBulkConfig::clear() {
+    setupCount = 0;
+}
+
+byte AdsBulkConfig::getCount() {
+    return setupCount;
+}
+
+AdsDeviceSetup &AdsBulkConfig::setup(byte index) {
+    return setups[index];
+}
+
+AdsBulkResult AdsBulkConfig::apply(bool resetFirst, bool verify) {
+    AdsBulkResult result;
+    result.registersWritten = 0;
+    result.registersSkipped = 0;
+    result.failedDevices = 0;
+
+    if (resetFirst) {
+        Ads1115Plus::sendGeneralCallReset();
+        for (byte i = 0; i < setupCount; i++) {
+            setups[i].ads->assumeResetState();
+        }
+    }
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+    AdsLinuxI2c::beginBatch();
+#endif
+
+    // Thresholds first: a comparator never runs with the thresholds of a previous configuration
+    for (byte i = 0; i < setupCount; i++) {
+        if (setups[i].mode != AdsDeviceMode::comparator) {
+            continue;
+        }
+        byte written = setups[i].ads->setThresholds(setups[i].highThreshold, setups[i].lowThreshold);
+        result.registersWritten += written;
+        result.registersSkipped += 2 - written;
+    }
+
+    for (byte i = 0; i < setupCount; i++) {
+        prepare(setups[i]);
+        if (setups[i].ads->writeConfigIfChanged()) {
+            result.registersWritten++;
+        } else {
+            result.registersSkipped++;
+        }
+    }
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+    if (!AdsLinuxI2c::endBatch()) {
+        // Some writes of the batch weren't acknowledged: the shadows can't be trusted, every device failed
+        for (byte i = 0; i < setupCount; i++) {
+            setups[i].ads->forgetRegisterState();
+            result.failedDevices |= 1 << i;
+        }
+        return result;
+    }
+#endif
+
+    if (verify) {
+        for (byte i = 0; i < setupCount; i++) {
+            if (!setups[i].ads->verifyRegisters()) {
+                result.failedDevices |= 1 << i;
+            }
+        }
+    }
+    return result;
+}
+
+// MARK: Private methods
+
+void AdsBulkConfig::prepare(const AdsDeviceSetup &setup) {
+    Ads1115Plus &ads = *setup.ads;
+    ads.setGain(setup.gain, false);
+    ads.setSampleSpeed(setup.speed, false);
+    ads.setMuxAndMode(setup.mux, setup.mode != AdsDeviceMode::singleShot);
+
+    ads.setComparatorMode(setup.comparatorMode, false);
+    ads.setComparatorPolarity(setup.comparatorPolarity, false);
+    ads.setComparatorLatching(setup.comparatorLatching, false);
+    ads.setComparatorAssert(setup.mode == AdsDeviceMode::comparator ? setup.comparatorQueue : ComparatorAssertConfig::disableAndSetHighImpedance, false);
+}
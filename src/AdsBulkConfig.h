@@ -0,0 +1,133 @@
+#ifndef __ADS_BULK_CONFIG_H__
+#define __ADS_BULK_CONFIG_H__
+
+#include "Ads1115Plus.h"
+
+/// The maximum number of devices in an AdsBulkConfig
+#define ADS_BULK_MAX_DEVICES 16
+
+/** How a device is left by AdsBulkConfig::apply() */
+enum class AdsDeviceMode {
+
+    /// Powered down, waiting for single shot readings
+    singleShot,
+
+    /// Converting continuously, comparator disabled
+    continuous,
+
+    /// Converting continuously, comparing every conversion with the thresholds
+    comparator
+};
+
+/** The configuration of a device in an AdsBulkConfig */
+struct AdsDeviceSetup {
+
+    /// The device configured
+    Ads1115Plus *ads;
+
+    /// How the device is left
+    AdsDeviceMode mode;
+
+    /// The channel (single or differential) converted
+    MuxConfig mux;
+
+    /// The gain used for the conversions
+    AdsGain gain;
+
+    /// The sample speed used for the conversions
+    AdsSampleSpeed speed;
+
+    /// The raw high threshold (comparator mode only)
+    int16_t highThreshold;
+
+    /// The raw low threshold (comparator mode only)
+    int16_t lowThreshold;
+
+    /// Traditional or window comparator (comparator mode only)
+    ComparatorModeConfig comparatorMode;
+
+    /// The polarity of the ALRT pin (comparator mode only)
+    ComparatorPolarityConfig comparatorPolarity;
+
+    /// Whether the ALRT pin latches (comparator mode only)
+    ComparatorLatchingConfig comparatorLatching;
+
+    /// The number of conversions beyond the thresholds before asserting (comparator mode only)
+    ComparatorAssertConfig comparatorQueue;
+};
+
+/** What AdsBulkConfig::apply() did */
+struct AdsBulkResult {
+
+    /// The number of registers written
+    uint16_t registersWritten;
+
+    /// The number of registers skipped because the device already held the value
+    uint16_t registersSkipped;
+
+    /// Bit n is set when the device of setup n didn't verify (or didn't answer), every bit when a batched transfer failed
+    uint16_t failedDevices;
+
+    /// Returns true if every device verified
+    bool succeeded() const;
+};
+
+/**
+ * The configuration of a set of devices, applied in a single pass
+ *
+ * apply() keeps the bus traffic to the minimum:
+ * - A single general call reset brings every device to its known reset values (optional)
+ * - Registers the device already holds (reset values or previous writes) are skipped, see Ads1115Plus::setThresholds()
+ * - The thresholds of every device are written first, then the configs, so each comparator starts with its thresholds
+ * - On Linux builds the writes are batched, up to I2C_RDWR_IOCTL_MAX_MSGS writes per ioctl
+ * - Registers are only read back to verify them (optional)
+ */
+class AdsBulkConfig {
+
+private:
+
+    /// The device configurations, in the order they were added
+    AdsDeviceSetup setups[ADS_BULK_MAX_DEVICES];
+
+    /// The number of devices configured
+    byte setupCount;
+
+    /// Sets the config fields of the device of [setup] (nothing is written)
+    static void prepare(const AdsDeviceSetup &setup);
+
+public:
+
+    /// Creates an empty configuration
+    AdsBulkConfig();
+
+    /**
+     * Adds a device, with the gain and sample speed it currently uses and the comparator defaults of
+     * Ads1115Plus::startComparatorModeOnMux() (the returned setup can be modified until apply())
+     * @return The setup of the device, nullptr if there are already ADS_BULK_MAX_DEVICES devices
+     */
+    AdsDeviceSetup *add(Ads1115Plus &ads, AdsDeviceMode mode = AdsDeviceMode::singleShot, MuxConfig mux = MuxConfig::channel0);
+
+    /// Adds a device in comparator mode on [mux] with the given raw thresholds, nullptr if full
+    AdsDeviceSetup *addComparator(Ads1115Plus &ads, MuxConfig mux, int16_t highThreshold, int16_t lowThreshold);
+
+    /// Removes every device
+    void clear();
+
+    /// Returns the number of devices
+    byte getCount();
+
+    /// Returns the setup at the given [index]
+    AdsDeviceSetup &setup(byte index);
+
+    /**
+     * Configures every device
+     * @param resetFirst Sends a general call reset first, so the registers left at their reset values aren't written.
+     * Note every device on the bus that supports the general call resets, including the ones not in this configuration
+     * @param verify Reads back the registers of every device and reports the ones that don't match
+     * @return What was done; on Linux, when a batched transfer isn't acknowledged every device is reported failed
+     * and its register shadows are forgotten (the next writes are performed)
+     */
+    AdsBulkResult apply(bool resetFirst = true, bool verify = true);
+};
+
+#endif
@@ -0,0 +1,222 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsCalibration.h"
+
+
+AdsCalibration::AdsCalibration() {
+    reset();
+}
+
+void AdsCalibration::reset() {
+    for (byte mux = 0; mux < ADS_MUX_COUNT; mux++) {
+        for (byte gain = 0; gain < ADS_GAIN_COUNT; gain++) {
+            entries[mux][gain].offset = 0;
+            entries[mux][gain].multiplier = Ads1115Plus::microvoltsMultiplier((AdsGain)((uint16_t)gain << 9));
+        }
+    }
+}
+
+void AdsCalibration::setOffset(MuxConfig mux, AdsGain gain, int16_t rawOffset) {
+    if (rawOffset > ADS_CALIBRATION_MAX_OFFSET) {
+        rawOffset = ADS_CALIBRATION_MAX_OFFSET;
+    } else if (rawOffset < -ADS_CALIBRATION_MAX_OFFSET) {
+        rawOffset = -ADS_CALIBRATION_MAX_OFFSET;
+    }
+    entryOf(mux, gain).offset = rawOffset;
+}
+
+int16_t AdsCalibration::getOffset(MuxConfig mux, AdsGain gain) {
+    return entryOf(mux, gain).offset;
+}
+
+void AdsCalibration::setGainCorrectionPpm(MuxConfig mux, AdsGain gain, int32_t gainCorrectionPpm) {
+    entryOf(mux, gain).multiplier = correctedMultiplier(gain, gainCorrectionPpm);
+}
+
+int32_t AdsCalibration::getGainCorrectionPpm(MuxConfig mux, AdsGain gain) {
+    int32_t ideal = Ads1115Plus::microvoltsMultiplier(gain);
+    int32_t difference = (int32_t)entryOf(mux, gain).multiplier - ideal;
+
+    // ppm = difference / ideal * 10^6, rounded to the nearest
+    int32_t scaled = difference * 1000000 / ideal;
+    int32_t remainder = difference * 1000000 % ideal;
+    if (2 * remainder >= ideal) {
+        scaled++;
+    } else if (2 * remainder <= -ideal) {
+        scaled--;
+    }
+    return scaled;
+}
+
+int32_t AdsCalibration::toMicrovolts(int16_t rawValue, MuxConfig mux, AdsGain gain) const {
+    const AdsCalibrationEntry &entry = entries[Ads1115Plus::muxIndex(mux)][Ads1115Plus::gainIndex(gain)];
+    byte shift = Ads1115Plus::microvoltsShift(gain);
+    return (((int32_t)rawValue - entry.offset) * entry.multiplier + ((int32_t)1 << (shift - 1))) >> shift;
+}
+
+int16_t AdsCalibration::toRawValue(int32_t microvolts, MuxConfig mux, AdsGain gain) const {
+    const AdsCalibrationEntry &entry = entries[Ads1115Plus::muxIndex(mux)][Ads1115Plus::gainIndex(gain)];
+    int32_t rawValue = (int32_t)Ads1115Plus::fixedPointToRawValue(microvolts, entry.multiplier, Ads1115Plus::microvoltsShift(gain)) + entry.offset;
+    return rawValue > 32767 ? 32767 : (rawValue < -32768 ? -32768 : (int16_t)rawValue);
+}
+
+// MARK: Measurement
+
+int16_t AdsCalibration::measureOffset(Ads1115Plus &ads, MuxConfig mux, AdsGain gain, byte samples) {
+    if (samples == 0) {
+        samples = 1;
+    }
+
+    AdsGain previousGain = ads.getGain();
+    MuxConfig previousMux = ads.getMux();
+    ads.setGain(gain, false);
+
+    int32_t sum = 0;
+    for (byte i = 0; i < samples; i++) {
+        sum += ads.readRawOnMux(mux);
+    }
+    ads.setGain(previousGain, false);
+    ads.setMux(previousMux); // Writes the restored config back when converting continuously
+
+    // Round to the nearest raw value
+    int32_t half = samples / 2;
+    int16_t offset = (sum >= 0 ? sum + half : sum - half) / samples;
+    setOffset(mux, gain, offset);
+    return getOffset(mux, gain);
+}
+
+int32_t AdsCalibration::measureGainCorrection(Ads1115Plus &ads, MuxConfig mux, AdsGain gain, int32_t referenceMicrovolts, byte samples) {
+    if (samples == 0) {
+        samples = 1;
+    }
+
+    AdsGain previousGain = ads.getGain();
+    MuxConfig previousMux = ads.getMux();
+    ads.setGain(gain, false);
+
+    int32_t sum = 0;
+    for (byte i = 0; i < samples; i++) {
+        sum += ads.readRawOnMux(mux);
+    }
+    ads.setGain(previousGain, false);
+    ads.setMux(previousMux);
+
+    // Measured microvolts with the offset removed and no gain correction (kept as a double since this isn't a fast path)
+    double rawValue = (double)sum / samples - getOffset(mux, gain);
+    double measured = rawValue * Ads1115Plus::microvoltsMultiplier(gain) / ((int32_t)1 << Ads1115Plus::microvoltsShift(gain));
+    if (measured == 0) {
+        return getGainCorrectionPpm(mux, gain);
+    }
+
+    int32_t gainCorrectionPpm = lround((referenceMicrovolts / measured - 1.0) * 1000000.0);
+    setGainCorrectionPpm(mux, gain, gainCorrectionPpm);
+    return getGainCorrectionPpm(mux, gain);
+}
+
+// MARK: Storage
+
+size_t AdsCalibration::writeImage(uint8_t *buffer, size_t capacity) {
+    if (capacity < ADS_CALIBRATION_IMAGE_SIZE) {
+        return 0;
+    }
+
+    size_t position = 0;
+    buffer[position++] = ADS_CALIBRATION_MAGIC & 0xFF;
+    buffer[position++] = ADS_CALIBRATION_MAGIC >> 8;
+    buffer[position++] = ADS_CALIBRATION_VERSION;
+    buffer[position++] = ADS_MUX_COUNT * ADS_GAIN_COUNT;
+
+    for (byte mux = 0; mux < ADS_MUX_COUNT; mux++) {
+        for (byte gain = 0; gain < ADS_GAIN_COUNT; gain++) {
+            MuxConfig muxConfig = (MuxConfig)((uint16_t)mux << 12);
+            AdsGain adsGain = (AdsGain)((uint16_t)gain << 9);
+            uint16_t offset = (uint16_t)getOffset(muxConfig, adsGain);
+            uint16_t gainCorrection = (uint16_t)(int16_t)getGainCorrectionPpm(muxConfig, adsGain);
+
+            buffer[position++] = offset & 0xFF;
+            buffer[position++] = offset >> 8;
+            buffer[position++] = gainCorrection & 0xFF;
+            buffer[position++] = gainCorrection >> 8;
+        }
+    }
+
+    uint16_t crc = crc16(buffer, position);
+    buffer[position++] = crc & 0xFF;
+    buffer[position++] = crc >> 8;
+    return position;
+}
+
+bool AdsCalibration::readImage(const uint8_t *buffer, size_t length) {
+    if (length < ADS_CALIBRATION_IMAGE_SIZE) {
+        return false;
+    }
+
+    uint16_t magic = buffer[0] | ((uint16_t)buffer[1] << 8);
+    if (magic != ADS_CALIBRATION_MAGIC || buffer[2] != ADS_CALIBRATION_VERSION || buffer[3] != ADS_MUX_COUNT * ADS_GAIN_COUNT) {
+        return false;
+    }
+
+    size_t crcPosition = ADS_CALIBRATION_IMAGE_SIZE - 2;
+    uint16_t crc = buffer[crcPosition] | ((uint16_t)buffer[crcPosition + 1] << 8);
+    if (crc != crc16(buffer, crcPosition)) {
+        return false;
+    }
+
+    size_t position = 4;
+    for (byte mux = 0; mux < ADS_MUX_COUNT; mux++) {
+        for (byte gain = 0; gain < ADS_GAIN_COUNT; gain++) {
+            MuxConfig muxConfig = (MuxConfig)((uint16_t)mux << 12);
+            AdsGain adsGain = (AdsGain)((uint16_t)gain << 9);
+            int16_t offset = (int16_t)(buffer[position] | ((uint16_t)buffer[position + 1] << 8));
+            int16_t gainCorrection = (int16_t)(buffer[position + 2] | ((uint16_t)buffer[position + 3] << 8));
+            position += 4;
+
+            setOffset(muxConfig, adsGain, offset);
+            setGainCorrectionPpm(muxConfig, adsGain, gainCorrection);
+        }
+    }
+    return true;
+}
+
+uint16_t AdsCalibration::crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (byte bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// MARK: Private methods
+
+AdsCalibrationEntry &AdsCalibration::entryOf(MuxConfig mux, AdsGain gain) {
+    return entries[Ads1115Plus::muxIndex(mux)][Ads1115Plus::gainIndex(gain)];
+}
+
+uint16_t AdsCalibration::correctedMultiplier(AdsGain gain, int32_t gainCorrectionPpm) {
+    // Keeps the stored value (and the ppm rebuilt from it) within an int16
+    if (gainCorrectionPpm > 32000) {
+        gainCorrectionPpm = 32000;
+    } else if (gainCorrectionPpm < -32000) {
+        gainCorrectionPpm = -32000;
+    }
+
+    // ideal * (10^6 + ppm) / 10^6 rounded, split so the product fits an int32 (ideal < 2^15)
+    int32_t ideal = Ads1115Plus::microvoltsMultiplier(gain);
+    int32_t correction = (ideal * gainCorrectionPpm + (gainCorrectionPpm >= 0 ? 500000 : -500000)) / 1000000;
+    return (uint16_t)(ideal + correction);
+}
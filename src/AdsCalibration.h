@@ -0,0 +1,123 @@
+#ifndef __ADS_CALIBRATION_H__
+#define __ADS_CALIBRATION_H__
+
+#include "Ads1115Plus.h"
+
+/// The first two bytes of a calibration image ("AC")
+#define ADS_CALIBRATION_MAGIC 0x4341
+
+/// The version of the calibration image layout
+#define ADS_CALIBRATION_VERSION 1
+
+/// The largest raw offset accepted by the tables (keeps the corrected product within an int32)
+#define ADS_CALIBRATION_MAX_OFFSET 2048
+
+/// The size in bytes of a calibration image (header + one entry per mux and gain + crc)
+#define ADS_CALIBRATION_IMAGE_SIZE (4 + ADS_MUX_COUNT * ADS_GAIN_COUNT * 4 + 2)
+
+/** The correction for a single mux and gain combination */
+struct AdsCalibrationEntry {
+
+    /// The raw value read with 0V on the input (subtracted before scaling)
+    int16_t offset;
+
+    /// The corrected microvolts / bit as a fixed point value (see Ads1115Plus::microvoltsMultiplier)
+    uint16_t multiplier;
+};
+
+/**
+ * Offset and gain correction tables for a single ADS1115 (one entry per mux and gain, 192 bytes)
+ * Set it on the device with Ads1115Plus::setCalibration() and use the microvolts methods to read corrected values
+ *
+ * The correction is applied in integer arithmetic:
+ * microvolts = ((rawValue - offset) * multiplier) >> Ads1115Plus::microvoltsShift(gain)
+ *
+ * The tables can be stored in EEPROM / flash or in a host file as an image of ADS_CALIBRATION_IMAGE_SIZE bytes (little endian):
+ * - uint16 magic (ADS_CALIBRATION_MAGIC), uint8 version (ADS_CALIBRATION_VERSION), uint8 entry count (48)
+ * - For each mux (MuxConfig order) and each gain (AdsGain order): int16 raw offset, int16 gain correction in ppm
+ * - uint16 CRC-16/CCITT-FALSE of all the previous bytes
+ */
+class AdsCalibration {
+
+private:
+
+    /// The corrections indexed by [Ads1115Plus::muxIndex][Ads1115Plus::gainIndex]
+    AdsCalibrationEntry entries[ADS_MUX_COUNT][ADS_GAIN_COUNT];
+
+    /// Returns the entry for the given [mux] and [gain]
+    AdsCalibrationEntry &entryOf(MuxConfig mux, AdsGain gain);
+
+    /// Returns the multiplier for the given [gain] corrected by [gainCorrectionPpm]
+    static uint16_t correctedMultiplier(AdsGain gain, int32_t gainCorrectionPpm);
+
+public:
+
+    /// Creates the tables with no correction (0 offset and the ideal datasheet LSB sizes)
+    AdsCalibration();
+
+    /// Removes all corrections (0 offset and the ideal datasheet LSB sizes)
+    void reset();
+
+    /**
+     * Sets the offset for the given [mux] and [gain]
+     * @param rawOffset The raw value read when the input is 0V, clamped to +/- ADS_CALIBRATION_MAX_OFFSET
+     */
+    void setOffset(MuxConfig mux, AdsGain gain, int16_t rawOffset);
+
+    /// Returns the raw offset for the given [mux] and [gain]
+    int16_t getOffset(MuxConfig mux, AdsGain gain);
+
+    /**
+     * Sets the gain correction for the given [mux] and [gain]
+     * @param gainCorrectionPpm The readings are scaled by (1 + gainCorrectionPpm / 10^6), clamped to +/- 32000 ppm
+     */
+    void setGainCorrectionPpm(MuxConfig mux, AdsGain gain, int32_t gainCorrectionPpm);
+
+    /// Returns the gain correction in ppm for the given [mux] and [gain] (rounded to the stored resolution)
+    int32_t getGainCorrectionPpm(MuxConfig mux, AdsGain gain);
+
+    /// Transforms the [rawValue] read on [mux] with [gain] into corrected microvolts
+    int32_t toMicrovolts(int16_t rawValue, MuxConfig mux, AdsGain gain) const;
+
+    /// Transforms the corrected [microvolts] into the raw value read on [mux] with [gain] (reverts toMicrovolts(), rounded)
+    int16_t toRawValue(int32_t microvolts, MuxConfig mux, AdsGain gain) const;
+
+    // MARK: Measurement
+
+    /**
+     * Measures the offset of [mux] with [gain], the inputs of [mux] must be shorted (e.g. A0 and A1 for differential01)
+     * The [ads] gain and mux are restored once the measurement is done
+     * @param samples The number of single shot readings averaged
+     * @return The measured raw offset (also stored in the tables)
+     */
+    int16_t measureOffset(Ads1115Plus &ads, MuxConfig mux, AdsGain gain, byte samples = 16);
+
+    /**
+     * Measures the gain correction of [mux] with [gain], the input must be set to a known reference
+     * Measure the offset first, since it is subtracted before comparing with the reference
+     * The [ads] gain and mux are restored once the measurement is done
+     * @param referenceMicrovolts The voltage applied to the input
+     * @param samples The number of single shot readings averaged
+     * @return The measured gain correction in ppm (also stored in the tables)
+     */
+    int32_t measureGainCorrection(Ads1115Plus &ads, MuxConfig mux, AdsGain gain, int32_t referenceMicrovolts, byte samples = 16);
+
+    // MARK: Storage
+
+    /**
+     * Writes the image of the tables (see class description) to the given [buffer]
+     * @return The number of bytes written (ADS_CALIBRATION_IMAGE_SIZE), 0 if [capacity] is too small
+     */
+    size_t writeImage(uint8_t *buffer, size_t capacity);
+
+    /**
+     * Loads the tables from the given image, the tables are left unchanged when the image isn't valid
+     * @return true if the magic, version, size and crc of the image are valid
+     */
+    bool readImage(const uint8_t *buffer, size_t length);
+
+    /// Returns the CRC-16/CCITT-FALSE of the given [data]
+    static uint16_t crc16(const uint8_t *data, size_t length);
+};
+
+#endif
@@ -0,0 +1,216 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsChannelStats.h"
+
+
+AdsChannelStats::AdsChannelStats() {
+    reset();
+}
+
+void AdsChannelStats::reset() {
+    count = 0;
+    segmentGain = AdsGain::twoThirds;
+    segmentCount = 0;
+    segmentSum = 0;
+    segmentSumSquared = 0;
+    segmentMin = 32767;
+    segmentMax = -32768;
+    foldedSum = 0;
+    foldedSumSquared = 0;
+    foldedSumSquaredHigh = 0;
+    foldedMin = INT32_MAX;
+    foldedMax = INT32_MIN;
+    firstMicros = 0;
+    lastMicros = 0;
+}
+
+void AdsChannelStats::add(int16_t rawValue, AdsGain gain) {
+    if (count == UINT32_MAX) {
+        return;
+    }
+    if (gain != segmentGain) {
+        fold(gain);
+    }
+
+    segmentCount++;
+    segmentSum += rawValue;
+    segmentSumSquared += (uint32_t)((int32_t)rawValue * rawValue);
+    if (rawValue < segmentMin) {
+        segmentMin = rawValue;
+    }
+    if (rawValue > segmentMax) {
+        segmentMax = rawValue;
+    }
+    count++;
+}
+
+void AdsChannelStats::add(const AdsSample &sample) {
+    if (count == UINT32_MAX) {
+        return;
+    }
+    if (count == 0) {
+        firstMicros = sample.timestampMicros;
+    }
+    lastMicros = sample.timestampMicros;
+    add(sample.raw, sample.gain);
+}
+
+uint32_t AdsChannelStats::getCount() {
+    return count;
+}
+
+void AdsChannelStats::snapshot(AdsStatsSnapshot &snapshot, bool startNewWindow) {
+    snapshot.count = count;
+    snapshot.firstMicros = firstMicros;
+    snapshot.lastMicros = lastMicros;
+    if (count == 0) {
+        snapshot.minMicrovolts = 0;
+        snapshot.maxMicrovolts = 0;
+        snapshot.meanMicrovolts = 0;
+        snapshot.rmsMicrovolts = 0;
+        snapshot.stddevMicrovolts = 0;
+        return;
+    }
+
+    // Everything in common units, the current segment included
+    uint32_t units = unitsPerRawValue(segmentGain);
+    int64_t sum = foldedSum + segmentSum * units;
+    uint32_t sumSquaredHigh = foldedSumSquaredHigh;
+    uint64_t sumSquared = foldedSumSquared;
+    addProduct(segmentSumSquared, units * units, sumSquaredHigh, sumSquared);
+    int32_t minimum = foldedMin;
+    int32_t maximum = foldedMax;
+    if (segmentCount > 0 && (int32_t)segmentMin * (int32_t)units < minimum) {
+        minimum = (int32_t)segmentMin * (int32_t)units;
+    }
+    if (segmentCount > 0 && (int32_t)segmentMax * (int32_t)units > maximum) {
+        maximum = (int32_t)segmentMax * (int32_t)units;
+    }
+
+    // 1 unit = 125 / 32 uV, squared 15625 / 1024 uV2
+    int64_t meanMicrovolts = divideRounded(sum * 125, (int64_t)count * 32);
+    uint64_t meanSquare = divide(sumSquaredHigh, sumSquared, count) * 15625 / 1024;
+
+    // The variance in common units before any rounding: (sumSquared - sum^2 / count) / count, with |sum| = q * count + r
+    // sum^2 / count = q * |sum| + q * r + r^2 / count, only the last term is rounded down
+    uint64_t absoluteSum = (uint64_t)(sum >= 0 ? sum : -sum);
+    uint32_t quotient = (uint32_t)(absoluteSum / count);
+    uint32_t remainder = (uint32_t)(absoluteSum % count);
+    uint32_t squaredSumHigh = 0;
+    uint64_t squaredSum = (uint64_t)remainder * remainder / count;
+    addProduct(absoluteSum, quotient, squaredSumHigh, squaredSum);
+    addProduct(remainder, quotient, squaredSumHigh, squaredSum);
+    subtract(sumSquaredHigh, sumSquared, squaredSumHigh, squaredSum);
+    uint64_t variance = divide(sumSquaredHigh, sumSquared, count) * 15625 / 1024;
+
+    snapshot.minMicrovolts = (int32_t)divideRounded((int64_t)minimum * 125, 32);
+    snapshot.maxMicrovolts = (int32_t)divideRounded((int64_t)maximum * 125, 32);
+    snapshot.meanMicrovolts = (int32_t)meanMicrovolts;
+    snapshot.rmsMicrovolts = (int32_t)squareRoot(meanSquare);
+    snapshot.stddevMicrovolts = (int32_t)squareRoot(variance);
+
+    if (startNewWindow) {
+        reset();
+    }
+}
+
+byte AdsChannelStats::unitsPerRawValue(AdsGain gain) {
+    // 187.5uV for 2/3, then 125uV halved at each step (see datasheet table 3)
+    return gain == AdsGain::twoThirds ? 48 : 64 >> Ads1115Plus::gainIndex(gain);
+}
+
+void AdsChannelStats::sampleCallback(const AdsSample &sample, void *stats) {
+    ((AdsChannelStats *)stats)->add(sample);
+}
+
+// MARK: Private methods
+
+void AdsChannelStats::fold(AdsGain gain) {
+    if (segmentCount > 0) {
+        uint32_t units = unitsPerRawValue(segmentGain);
+        foldedSum += segmentSum * units;
+        addProduct(segmentSumSquared, units * units, foldedSumSquaredHigh, foldedSumSquared);
+        if ((int32_t)segmentMin * (int32_t)units < foldedMin) {
+            foldedMin = (int32_t)segmentMin * (int32_t)units;
+        }
+        if ((int32_t)segmentMax * (int32_t)units > foldedMax) {
+            foldedMax = (int32_t)segmentMax * (int32_t)units;
+        }
+    }
+
+    segmentGain = gain;
+    segmentCount = 0;
+    segmentSum = 0;
+    segmentSumSquared = 0;
+    segmentMin = 32767;
+    segmentMax = -32768;
+}
+
+void AdsChannelStats::addProduct(uint64_t value, uint32_t factor, uint32_t &high, uint64_t &low) {
+    // Split in 32 bit halves: value * factor = upper * 2^32 + lower, each product fits 64 bits
+    uint64_t lower = (value & 0xFFFFFFFF) * factor;
+    uint64_t upper = (value >> 32) * factor;
+    high += (uint32_t)(upper >> 32);
+
+    uint64_t sum = low + (upper << 32);
+    if (sum < low) {
+        high++;
+    }
+    low = sum + lower;
+    if (low < sum) {
+        high++;
+    }
+}
+
+void AdsChannelStats::subtract(uint32_t &high, uint64_t &low, uint32_t subtrahendHigh, uint64_t subtrahendLow) {
+    high -= subtrahendHigh;
+    if (low < subtrahendLow) {
+        high--;
+    }
+    low -= subtrahendLow;
+}
+
+uint64_t AdsChannelStats::divide(uint32_t high, uint64_t low, uint32_t divisor) {
+    // Long division by 32 bit words, the remainder stays below the divisor so each step fits 64 bits
+    uint64_t remainder = high % divisor;
+    uint64_t current = (remainder << 32) | (low >> 32);
+    uint64_t quotient = current / divisor;
+    remainder = current % divisor;
+    current = (remainder << 32) | (low & 0xFFFFFFFF);
+    return (quotient << 32) | (current / divisor);
+}
+
+int64_t AdsChannelStats::divideRounded(int64_t value, int64_t divisor) {
+    return (value >= 0 ? value + divisor / 2 : value - divisor / 2) / divisor;
+}
+
+uint32_t AdsChannelStats::squareRoot(uint64_t value) {
+    // Bit by bit, 32 iterations at most
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
@@ -0,0 +1,140 @@
+#ifndef __ADS_CHANNEL_STATS_H__
+#define __ADS_CHANNEL_STATS_H__
+
+#include "Ads1115Plus.h"
+
+/** The statistics of a window of samples, in microvolts (ideal datasheet LSB sizes, no calibration) */
+struct AdsStatsSnapshot {
+
+    /// The number of samples in the window
+    uint32_t count;
+
+    /// The smallest value
+    int32_t minMicrovolts;
+
+    /// The largest value
+    int32_t maxMicrovolts;
+
+    /// The mean value
+    int32_t meanMicrovolts;
+
+    /// The root mean square value
+    int32_t rmsMicrovolts;
+
+    /// The standard deviation
+    int32_t stddevMicrovolts;
+
+    /// The timestamp of the first sample of the window
+    uint32_t firstMicros;
+
+    /// The timestamp of the last sample of the window
+    uint32_t lastMicros;
+};
+
+/**
+ * Running min / max / mean / RMS of a channel, with integer math only and O(1) work per sample
+ *
+ * Samples are accumulated as raw values (a 16 bit square and 64 bit additions per sample) while the gain stays the
+ * same. When the gain changes the sums are folded into a common unit of 1/32 of the gain one LSB (3.90625uV, every
+ * gain LSB is an integer multiple of it), so a window can mix gains and stay exact. snapshot() reads the window
+ * (and optionally starts the next one) without stopping the acquisition.
+ * A window holds up to 4294967295 samples (more than 57 days at 860 SPS), the samples added to a full window are
+ * ignored. The squares are summed in 96 bits (a 64 bit word and a 32 bit overflow word), a square in common units
+ * takes up to 41 bits and 64 bits would only hold about 7.4 million samples at the 2/3 gain.
+ * add() and snapshot() must be called from the same context (or with the interrupts disabled around snapshot())
+ */
+class AdsChannelStats {
+
+private:
+
+    /// The number of samples in the window
+    uint32_t count;
+
+    /// The gain of the current segment (samples since the last gain change)
+    AdsGain segmentGain;
+
+    /// The number of samples in the current segment
+    uint32_t segmentCount;
+
+    /// The sum of the raw values of the current segment
+    int64_t segmentSum;
+
+    /// The sum of the squared raw values of the current segment
+    uint64_t segmentSumSquared;
+
+    /// The smallest raw value of the current segment
+    int16_t segmentMin;
+
+    /// The largest raw value of the current segment
+    int16_t segmentMax;
+
+    /// The sum of the previous segments in common units
+    int64_t foldedSum;
+
+    /// The sum of the squares of the previous segments in common units (low 64 bits)
+    uint64_t foldedSumSquared;
+
+    /// The bits of the sum of the squares of the previous segments above the 64 of [foldedSumSquared]
+    uint32_t foldedSumSquaredHigh;
+
+    /// The smallest value of the previous segments in common units
+    int32_t foldedMin;
+
+    /// The largest value of the previous segments in common units
+    int32_t foldedMax;
+
+    /// The timestamp of the first sample of the window
+    uint32_t firstMicros;
+
+    /// The timestamp of the last sample of the window
+    uint32_t lastMicros;
+
+    /// Adds the current segment to the folded sums and starts a new one with [gain]
+    void fold(AdsGain gain);
+
+    /// Adds [value] * [factor] to the 96 bit number [high]:[low]
+    static void addProduct(uint64_t value, uint32_t factor, uint32_t &high, uint64_t &low);
+
+    /// Subtracts the 96 bit number [subtrahendHigh]:[subtrahendLow] (not larger) from [high]:[low]
+    static void subtract(uint32_t &high, uint64_t &low, uint32_t subtrahendHigh, uint64_t subtrahendLow);
+
+    /// Returns the 96 bit number [high]:[low] divided by [divisor] (> 0), the quotient must fit 64 bits
+    static uint64_t divide(uint32_t high, uint64_t low, uint32_t divisor);
+
+    /// Returns [value] / [divisor] rounded to the nearest ([divisor] > 0)
+    static int64_t divideRounded(int64_t value, int64_t divisor);
+
+    /// Returns the square root of [value] rounded down
+    static uint32_t squareRoot(uint64_t value);
+
+public:
+
+    /// Creates an empty window
+    AdsChannelStats();
+
+    /// Empties the window
+    void reset();
+
+    /// Adds a raw value converted with [gain] (ignored when the window is full)
+    void add(int16_t rawValue, AdsGain gain);
+
+    /// Adds the given [sample] (its raw value, gain and timestamp)
+    void add(const AdsSample &sample);
+
+    /// Returns the number of samples in the window
+    uint32_t getCount();
+
+    /**
+     * Computes the statistics of the window (all zero when empty)
+     * @param startNewWindow Empties the window once read, so the next snapshot covers the samples added meanwhile
+     */
+    void snapshot(AdsStatsSnapshot &snapshot, bool startNewWindow = true);
+
+    /// Returns the LSB of the given [gain] in common units (1/32 of the gain one LSB)
+    static byte unitsPerRawValue(AdsGain gain);
+
+    /// Scanner callback adding each sample to the AdsChannelStats given as [stats]
+    static void sampleCallback(const AdsSample &sample, void *stats);
+};
+
+#endif
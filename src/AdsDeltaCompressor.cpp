@@ -0,0 +1,122 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsDeltaCompressor.h"
+
+
+AdsDeltaEncoder::AdsDeltaEncoder() {
+    reset();
+}
+
+void AdsDeltaEncoder::reset() {
+    for (byte i = 0; i < ADS_DELTA_MAX_CHANNELS; i++) {
+        lastValues[i] = 0;
+    }
+}
+
+size_t AdsDeltaEncoder::encode(byte channel, int16_t value, uint8_t *buffer) {
+    channel %= ADS_DELTA_MAX_CHANNELS;
+    uint16_t encoded = zigzag((int16_t)((uint16_t)value - (uint16_t)lastValues[channel]));
+    lastValues[channel] = value;
+
+    size_t length = 0;
+    while (encoded >= 0x80) {
+        buffer[length++] = (encoded & 0x7F) | 0x80;
+        encoded >>= 7;
+    }
+    buffer[length++] = encoded;
+    return length;
+}
+
+size_t AdsDeltaEncoder::encodeBlock(byte channel, const int16_t *values, size_t count, uint8_t *buffer, size_t capacity, size_t &encodedCount) {
+    size_t length = 0;
+    encodedCount = 0;
+    while (encodedCount < count && capacity - length >= ADS_DELTA_MAX_BYTES_PER_VALUE) {
+        length += encode(channel, values[encodedCount], buffer + length);
+        encodedCount++;
+    }
+    return length;
+}
+
+size_t AdsDeltaEncoder::encodeSamples(const AdsSample *samples, size_t count, uint8_t *buffer, size_t capacity, size_t &encodedCount) {
+    size_t length = 0;
+    encodedCount = 0;
+    while (encodedCount < count && capacity - length >= ADS_DELTA_MAX_BYTES_PER_VALUE) {
+        const AdsSample &sample = samples[encodedCount];
+        length += encode(channelOf(sample), sample.raw, buffer + length);
+        encodedCount++;
+    }
+    return length;
+}
+
+byte AdsDeltaEncoder::channelOf(const AdsSample &sample) {
+    return ((sample.device & 0x3) << 3) | Ads1115Plus::muxIndex(sample.mux);
+}
+
+uint16_t AdsDeltaEncoder::zigzag(int16_t difference) {
+    return ((uint16_t)difference << 1) ^ (uint16_t)(difference >> 15);
+}
+
+int16_t AdsDeltaEncoder::unzigzag(uint16_t value) {
+    return (int16_t)((value >> 1) ^ (uint16_t)-(int16_t)(value & 1));
+}
+
+// MARK: Decoder
+
+AdsDeltaDecoder::AdsDeltaDecoder() {
+    reset();
+}
+
+void AdsDeltaDecoder::reset() {
+    for (byte i = 0; i < ADS_DELTA_MAX_CHANNELS; i++) {
+        lastValues[i] = 0;
+    }
+}
+
+size_t AdsDeltaDecoder::decode(byte channel, const uint8_t *data, size_t length, int16_t &value) {
+    uint16_t encoded = 0;
+    size_t position = 0;
+    byte shift = 0;
+
+    while (true) {
+        if (position >= length || position >= ADS_DELTA_MAX_BYTES_PER_VALUE) {
+            return 0;
+        }
+        uint8_t current = data[position++];
+        encoded |= (uint16_t)(current & 0x7F) << shift;
+        if ((current & 0x80) == 0) {
+            break;
+        }
+        shift += 7;
+    }
+
+    channel %= ADS_DELTA_MAX_CHANNELS;
+    lastValues[channel] = (int16_t)((uint16_t)lastValues[channel] + (uint16_t)AdsDeltaEncoder::unzigzag(encoded));
+    value = lastValues[channel];
+    return position;
+}
+
+size_t AdsDeltaDecoder::decodeBlock(byte channel, const uint8_t *data, size_t length, int16_t *values, size_t count, size_t &decodedCount) {
+    size_t position = 0;
+    decodedCount = 0;
+    while (decodedCount < count) {
+        size_t consumed = decode(channel, data + position, length - position, values[decodedCount]);
+        if (consumed == 0) {
+            break;
+        }
+        position += consumed;
+        decodedCount++;
+    }
+    return position;
+}
@@ -0,0 +1,101 @@
+#ifndef __ADS_DELTA_COMPRESSOR_H__
+#define __ADS_DELTA_COMPRESSOR_H__
+
+#include "Ads1115Plus.h"
+
+/// The number of channels tracked by the compressor (4 devices * 8 mux configs, see AdsDeltaEncoder::channelOf)
+#define ADS_DELTA_MAX_CHANNELS 32
+
+/// The largest number of bytes a single value is encoded into
+#define ADS_DELTA_MAX_BYTES_PER_VALUE 3
+
+/**
+ * Compresses raw values by sending the difference with the previous value of the same channel
+ * Each difference is zigzag encoded (small negative values become small positive values) and written as a varint
+ * (7 bits per byte, the high bit set when more bytes follow):
+ * - Changes within +/- 63 LSB take 1 byte, within +/- 8191 LSB take 2 bytes, any other change takes 3 bytes
+ * - Differences wrap around 16 bits, so the cost per value is bounded and no 32 bit math is needed
+ *
+ * The encoder only keeps the last value of each channel (no heap, 64 bytes), the decoder must be given the
+ * same channel sequence (e.g. the scan order) and both start from 0 after reset()
+ */
+class AdsDeltaEncoder {
+
+private:
+
+    /// The last value encoded for each channel
+    int16_t lastValues[ADS_DELTA_MAX_CHANNELS];
+
+public:
+
+    /// Creates an encoder with every channel starting at 0
+    AdsDeltaEncoder();
+
+    /// Sets every channel back to 0 (the decoder has to be reset as well)
+    void reset();
+
+    /**
+     * Encodes a single [value] of the given [channel]
+     * @param buffer Receives the encoded value, must hold at least ADS_DELTA_MAX_BYTES_PER_VALUE bytes
+     * @return The number of bytes written (1 to 3)
+     */
+    size_t encode(byte channel, int16_t value, uint8_t *buffer);
+
+    /**
+     * Encodes [count] values of the given [channel]
+     * @param capacity The size of the [buffer], encoding stops at the first value that doesn't fit
+     * @param encodedCount Set to the number of values encoded
+     * @return The number of bytes written
+     */
+    size_t encodeBlock(byte channel, const int16_t *values, size_t count, uint8_t *buffer, size_t capacity, size_t &encodedCount);
+
+    /**
+     * Encodes the raw value of [count] samples, each one on the channel given by channelOf(sample)
+     * @param capacity The size of the [buffer], encoding stops at the first sample that doesn't fit
+     * @param encodedCount Set to the number of samples encoded
+     * @return The number of bytes written
+     */
+    size_t encodeSamples(const AdsSample *samples, size_t count, uint8_t *buffer, size_t capacity, size_t &encodedCount);
+
+    /// Returns the channel used for the given [sample] (device * 8 + mux index)
+    static byte channelOf(const AdsSample &sample);
+
+    /// Maps a signed difference to an unsigned value (0, -1, 1, -2... become 0, 1, 2, 3...)
+    static uint16_t zigzag(int16_t difference);
+
+    /// Reverts zigzag()
+    static int16_t unzigzag(uint16_t value);
+};
+
+/** Decompresses the values written by AdsDeltaEncoder (plain C++, no bus access, so it can run on the host) */
+class AdsDeltaDecoder {
+
+private:
+
+    /// The last value decoded for each channel
+    int16_t lastValues[ADS_DELTA_MAX_CHANNELS];
+
+public:
+
+    /// Creates a decoder with every channel starting at 0
+    AdsDeltaDecoder();
+
+    /// Sets every channel back to 0
+    void reset();
+
+    /**
+     * Decodes a single value of the given [channel]
+     * @param value Set to the decoded value
+     * @return The number of bytes consumed, 0 if [length] doesn't hold a complete value
+     */
+    size_t decode(byte channel, const uint8_t *data, size_t length, int16_t &value);
+
+    /**
+     * Decodes up to [count] values of the given [channel]
+     * @param decodedCount Set to the number of values decoded
+     * @return The number of bytes consumed
+     */
+    size_t decodeBlock(byte channel, const uint8_t *data, size_t length, int16_t *values, size_t count, size_t &decodedCount);
+};
+
+#endif
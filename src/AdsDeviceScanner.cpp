@@ -0,0 +1,122 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsDeviceScanner.h"
+
+
+AdsDeviceScanner::AdsDeviceScanner(AdsGain gain, AdsSampleSpeed dataRate) {
+    for (byte i = 0; i < ADS_MAX_DEVICES_PER_BUS; i++) {
+        devices[i] = Ads1115Plus(addressOf(i), gain, dataRate);
+    }
+    presentMask = 0;
+    nextProbeIndex = 0;
+    lastChangeIndex = 0;
+}
+
+byte AdsDeviceScanner::scan(bool resetDevices) {
+    if (resetDevices) {
+        Ads1115Plus::sendGeneralCallReset();
+
+        // Every ADS1115 on the bus reloaded its reset values, the register shadows must follow
+        for (byte i = 0; i < ADS_MAX_DEVICES_PER_BUS; i++) {
+            devices[i].assumeResetState();
+        }
+    }
+
+    for (byte i = 0; i < ADS_MAX_DEVICES_PER_BUS; i++) {
+        AdsAddress address = addressOf(i);
+
+        // Devices already found may be in use (configured), so like probeNext() only the acknowledge is checked
+        if (presentMask & (1 << i)) {
+            if (!Ads1115Plus::isResponding(address)) {
+                presentMask &= ~(1 << i);
+            }
+            continue;
+        }
+
+        if (Ads1115Plus::isUnconfiguredAds1115(address)) {
+            presentMask |= 1 << i;
+
+            // Found with its reset config: plugged again or power cycled, not in the state its shadows remember
+            if (!resetDevices) {
+                devices[i].forgetRegisterState();
+            }
+        }
+    }
+    nextProbeIndex = 0;
+    return count();
+}
+
+AdsPresenceChange AdsDeviceScanner::probeNext() {
+    byte index = nextProbeIndex;
+    nextProbeIndex = (nextProbeIndex + 1) % ADS_MAX_DEVICES_PER_BUS;
+
+    bool wasPresent = presentMask & (1 << index);
+    AdsAddress address = addressOf(index);
+
+    if (wasPresent) {
+        // Devices in use are already configured, so only the acknowledge can be checked
+        if (Ads1115Plus::isResponding(address)) {
+            return AdsPresenceChange::none;
+        }
+        presentMask &= ~(1 << index);
+        lastChangeIndex = index;
+        return AdsPresenceChange::removed;
+    }
+
+    // Check for the acknowledge first, so an empty address costs a single empty transaction
+    if (!Ads1115Plus::isResponding(address) || !Ads1115Plus::isUnconfiguredAds1115(address)) {
+        return AdsPresenceChange::none;
+    }
+    presentMask |= 1 << index;
+    lastChangeIndex = index;
+    devices[index].forgetRegisterState();
+    return AdsPresenceChange::added;
+}
+
+AdsAddress AdsDeviceScanner::lastChangedAddress() {
+    return addressOf(lastChangeIndex);
+}
+
+bool AdsDeviceScanner::isPresent(AdsAddress address) {
+    return presentMask & (1 << indexOf(address));
+}
+
+Ads1115Plus *AdsDeviceScanner::device(AdsAddress address) {
+    return isPresent(address) ? &devices[indexOf(address)] : nullptr;
+}
+
+byte AdsDeviceScanner::getPresentMask() {
+    return presentMask;
+}
+
+byte AdsDeviceScanner::count() {
+    byte found = 0;
+    for (byte i = 0; i < ADS_MAX_DEVICES_PER_BUS; i++) {
+        if (presentMask & (1 << i)) {
+            found++;
+        }
+    }
+    return found;
+}
+
+// MARK: Private methods
+
+byte AdsDeviceScanner::indexOf(AdsAddress address) {
+    return ((byte)address - (byte)AdsAddress::gnd) % ADS_MAX_DEVICES_PER_BUS;
+}
+
+AdsAddress AdsDeviceScanner::addressOf(byte index) {
+    return (AdsAddress)((byte)AdsAddress::gnd + index);
+}
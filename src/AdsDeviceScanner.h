@@ -0,0 +1,96 @@
+#ifndef __ADS_DEVICE_SCANNER_H__
+#define __ADS_DEVICE_SCANNER_H__
+
+#include "Ads1115Plus.h"
+
+/// The number of addresses an ADS1115 can take on a single i2c bus (0x48 to 0x4B)
+#define ADS_MAX_DEVICES_PER_BUS 4
+
+/** The result of probing a single address with AdsDeviceScanner::probeNext() */
+enum class AdsPresenceChange: byte {
+
+    /// The probed address kept its previous state
+    none = 0,
+
+    /// An unconfigured ADS1115 was found on an address that was empty
+    added = 1,
+
+    /// A device that was present stopped acknowledging its address
+    removed = 2
+};
+
+/**
+ * Discovers the ADS1115 connected to the i2c bus (addresses 0x48 to 0x4B) and keeps track of boards being added or removed
+ *
+ * scan() probes the four addresses and keeps a ready to use Ads1115Plus for each ADS1115 found
+ * probeNext() probes a single address per call (round robin), so it can be called from loop() without stalling the
+ * acquisition of the devices that are still present:
+ * - Present devices are only checked for an acknowledge (an empty i2c transaction)
+ * - Empty addresses are also checked for the config register reset value, so other i2c devices aren't taken as an ADS1115
+ */
+class AdsDeviceScanner {
+
+private:
+
+    /// The devices for each address, indexed by (address - AdsAddress::gnd)
+    Ads1115Plus devices[ADS_MAX_DEVICES_PER_BUS];
+
+    /// Bit i is set when the device with address (AdsAddress::gnd + i) is present
+    byte presentMask;
+
+    /// The index of the address probed by the next call to probeNext()
+    byte nextProbeIndex;
+
+    /// The index of the address with the last change reported by probeNext()
+    byte lastChangeIndex;
+
+    /// Returns the index (0 to 3) of the given [address]
+    static byte indexOf(AdsAddress address);
+
+    /// Returns the address for the given [index] (0 to 3)
+    static AdsAddress addressOf(byte index);
+
+public:
+
+    /**
+     * Creates a scanner, the devices found will be configured with the given [gain] and [dataRate]
+     * No i2c traffic happens until scan() or probeNext() are called
+     */
+    AdsDeviceScanner(AdsGain gain = AdsGain::twoThirds, AdsSampleSpeed dataRate = AdsSampleSpeed::sps64);
+
+    /**
+     * Probes all four addresses and updates the set of present devices
+     * The devices already present stay present while they acknowledge (they may be configured and in use), the other
+     * addresses are checked for the config register reset value (see probeNext())
+     * @param resetDevices if true a general call reset is sent first, so ADS1115 left configured by a previous run are detected as well
+     * @return The number of ADS1115 found
+     */
+    byte scan(bool resetDevices = false);
+
+    /**
+     * Probes the next address (round robin through the four addresses)
+     * Use lastChangedAddress() to know which address was added or removed
+     * @return Whether the presence of the probed address changed
+     */
+    AdsPresenceChange probeNext();
+
+    /// Returns the address of the last change reported by probeNext()
+    AdsAddress lastChangedAddress();
+
+    /// Returns true if an ADS1115 is present on the given [address]
+    bool isPresent(AdsAddress address);
+
+    /// Returns the device for the given [address], or nullptr if it isn't present
+    Ads1115Plus *device(AdsAddress address);
+
+    /**
+     * Returns the present devices as a bit mask
+     * Bit i is set when the device with address (AdsAddress::gnd + i) is present
+     */
+    byte getPresentMask();
+
+    /// Returns the number of present devices
+    byte count();
+};
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsDutyCycleLogger.h"
+
+
+AdsDutyCycleLogger::AdsDutyCycleLogger(AdsScanner &scanner) : scanner(scanner) {
+    scanPeriodMicros = 0;
+}
+
+bool AdsDutyCycleLogger::start(unsigned long scanPeriodMicros, bool keepSpeeds) {
+    byte slotCount = scanner.getSlotCount();
+    if (slotCount == 0) {
+        return false;
+    }
+
+    scanner.stop();
+    if (!keepSpeeds) {
+        for (byte i = 0; i < slotCount; i++) {
+            scanner.slot(i).speed = AdsSampleSpeed::sps860;
+        }
+    }
+
+    // One conversion per grid point, spread over the scan period
+    unsigned long periodMicros = scanPeriodMicros / slotCount;
+    if (periodMicros < scanner.minimumPeriodMicros()) {
+        return false;
+    }
+    this->scanPeriodMicros = scanPeriodMicros;
+    return scanner.start(periodMicros);
+}
+
+void AdsDutyCycleLogger::stop() {
+    scanner.stop();
+}
+
+bool AdsDutyCycleLogger::poll() {
+    return scanner.poll();
+}
+
+uint32_t AdsDutyCycleLogger::sleepMicros() {
+    return scanner.microsUntilNextEvent();
+}
+
+AdsEnergyEstimate AdsDutyCycleLogger::estimate() {
+    byte slotCount = scanner.getSlotCount();
+    AdsEnergyEstimate result = { 0, 0, 0, 0 };
+    if (slotCount == 0 || scanPeriodMicros == 0) {
+        return result;
+    }
+
+    // Sum the conversion times of the slots (they may use different speeds), including the settling conversions
+    uint32_t activeMicros = 0;
+    uint16_t conversions = 0;
+    for (byte i = 0; i < slotCount; i++) {
+        byte slotConversions = settlesEachScan(i) ? 2 : 1;
+        activeMicros += slotConversions * Ads1115Plus::samplePeriodMicros(scanner.slot(i).speed);
+        conversions += slotConversions;
+    }
+
+    uint64_t idleMicros = scanPeriodMicros > activeMicros ? scanPeriodMicros - activeMicros : 0;
+    uint64_t charge = ((uint64_t)activeMicros * ADS_ACTIVE_CURRENT_NANOAMPS + idleMicros * ADS_POWER_DOWN_CURRENT_NANOAMPS) / 1000000;
+
+    result.activeMicrosPerPeriod = activeMicros;
+    result.chargePerConversionNanocoulombs = (uint64_t)activeMicros * ADS_ACTIVE_CURRENT_NANOAMPS / conversions / 1000000;
+    result.chargePerSampleNanocoulombs = charge / slotCount;
+    result.averageCurrentNanoamps = charge * 1000000 / scanPeriodMicros;
+    return result;
+}
+
+AdsEnergyEstimate AdsDutyCycleLogger::estimate(AdsSampleSpeed speed, unsigned long periodMicros, uint16_t conversionsPerPeriod, uint16_t samplesPerPeriod) {
+    AdsEnergyEstimate result = { 0, 0, 0, 0 };
+    if (periodMicros == 0 || conversionsPerPeriod == 0 || samplesPerPeriod == 0) {
+        return result;
+    }
+
+    uint32_t conversionMicros = Ads1115Plus::samplePeriodMicros(speed);
+    uint64_t activeMicros = (uint64_t)conversionMicros * conversionsPerPeriod;
+    uint64_t idleMicros = periodMicros > activeMicros ? periodMicros - activeMicros : 0;
+    uint64_t charge = (activeMicros * ADS_ACTIVE_CURRENT_NANOAMPS + idleMicros * ADS_POWER_DOWN_CURRENT_NANOAMPS) / 1000000;
+
+    result.activeMicrosPerPeriod = activeMicros;
+    result.chargePerConversionNanocoulombs = (uint64_t)conversionMicros * ADS_ACTIVE_CURRENT_NANOAMPS / 1000000;
+    result.chargePerSampleNanocoulombs = charge / samplesPerPeriod;
+    result.averageCurrentNanoamps = charge * 1000000 / periodMicros;
+    return result;
+}
+
+// MARK: Private methods
+
+bool AdsDutyCycleLogger::settlesEachScan(byte index) {
+    byte slotCount = scanner.getSlotCount();
+    if (slotCount < 2) {
+        return false;
+    }
+
+    // The previous conversion is the one of the previous slot (cyclically)
+    const AdsScanSlot &current = scanner.slot(index);
+    const AdsScanSlot &previous = scanner.slot(index == 0 ? slotCount - 1 : index - 1);
+    bool switched = current.mux != previous.mux || current.gain != previous.gain || current.speed != previous.speed;
+    return current.discardAfterSwitch && switched;
+}
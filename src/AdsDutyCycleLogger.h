@@ -0,0 +1,82 @@
+#ifndef __ADS_DUTY_CYCLE_LOGGER_H__
+#define __ADS_DUTY_CYCLE_LOGGER_H__
+
+#include "Ads1115Plus.h"
+#include "AdsScanner.h"
+
+/** The estimated supply charge of a duty cycled acquisition (from the typical datasheet currents) */
+struct AdsEnergyEstimate {
+
+    /// The time the device spends converting per scan period
+    uint32_t activeMicrosPerPeriod;
+
+    /// The average charge of a conversion in nanocoulombs
+    uint32_t chargePerConversionNanocoulombs;
+
+    /// The charge per useful sample in nanocoulombs, including the share of the power-down time
+    uint32_t chargePerSampleNanocoulombs;
+
+    /// The average supply current in nanoamps
+    uint32_t averageCurrentNanoamps;
+};
+
+/**
+ * Slow, low power logging: single shot conversions on a schedule, the device powers down in between
+ *
+ * The slots of the scanner are set to the fastest sample speed, which gives the shortest time converting (1.16ms at
+ * 860 SPS instead of 125ms at 8 SPS, about 100 times less charge per sample), at the cost of some noise (see
+ * AdsRateOptimizer to check it is acceptable). The scan list is read every scan period, the conversions evenly spread
+ * over it, and sleepMicros() tells how long the host can sleep before the next poll().
+ *
+ * estimate() models the supply charge from ADS_ACTIVE_CURRENT_NANOAMPS while converting and
+ * ADS_POWER_DOWN_CURRENT_NANOAMPS otherwise, the i2c transfers and the wake up are not included.
+ * The same model is used by AdsSimulator::getChargeNanocoulombs(), to compare configurations on the host
+ */
+class AdsDutyCycleLogger {
+
+private:
+
+    /// Reads the slots
+    AdsScanner &scanner;
+
+    /// The time between two reads of the whole scan list
+    unsigned long scanPeriodMicros;
+
+    /// Returns whether the slot at [index] performs a settling conversion on every scan
+    bool settlesEachScan(byte index);
+
+public:
+
+    /// Creates a logger reading the slots of the given [scanner]
+    AdsDutyCycleLogger(AdsScanner &scanner);
+
+    /**
+     * Sets every slot to AdsSampleSpeed::sps860 and starts reading the scan list every [scanPeriodMicros]
+     * @param keepSpeeds Keeps the sample speed of the slots instead (e.g. when chosen by AdsRateOptimizer)
+     * @return false if the scan list is empty or the period is too short for its conversions
+     */
+    bool start(unsigned long scanPeriodMicros, bool keepSpeeds = false);
+
+    /// Stops logging (the device powers down after the conversion being performed)
+    void stop();
+
+    /**
+     * Reads the finished conversion and starts the next one when due (the samples go to the scanner callback)
+     * @return true if a sample was produced
+     */
+    bool poll();
+
+    /// Returns how long the host can sleep before calling poll() again (0xFFFFFFFF when stopped)
+    uint32_t sleepMicros();
+
+    /// Returns the estimated supply charge of the current scan list and period
+    AdsEnergyEstimate estimate();
+
+    /**
+     * Returns the estimated supply charge of [conversionsPerPeriod] conversions at [speed] every [periodMicros]
+     * @param samplesPerPeriod The useful samples among the conversions (the others being settling conversions)
+     */
+    static AdsEnergyEstimate estimate(AdsSampleSpeed speed, unsigned long periodMicros, uint16_t conversionsPerPeriod = 1, uint16_t samplesPerPeriod = 1);
+};
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "Ads1115Plus.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+int AdsLinuxI2c::busFile = -1;
+AdsI2cTransferHook AdsLinuxI2c::transferHook = nullptr;
+void *AdsLinuxI2c::transferHookContext = nullptr;
+bool AdsLinuxI2c::batching = false;
+struct i2c_msg AdsLinuxI2c::batchMessages[I2C_RDWR_IOCTL_MAX_MSGS];
+uint8_t AdsLinuxI2c::batchData[I2C_RDWR_IOCTL_MAX_MSGS][ADS_LINUX_I2C_BATCH_BYTES];
+uint32_t AdsLinuxI2c::batchCount = 0;
+bool AdsLinuxI2c::batchFailed = false;
+
+
+bool AdsLinuxI2c::open(const char *devicePath) {
+    close();
+    busFile = ::open(devicePath, O_RDWR | O_CLOEXEC);
+    return busFile >= 0;
+}
+
+void AdsLinuxI2c::close() {
+    if (busFile >= 0) {
+        ::close(busFile);
+        busFile = -1;
+    }
+}
+
+bool AdsLinuxI2c::isOpen() {
+    return busFile >= 0 || transferHook != nullptr;
+}
+
+void AdsLinuxI2c::setTransferHook(AdsI2cTransferHook hook, void *context) {
+    transferHook = hook;
+    transferHookContext = context;
+}
+
+bool AdsLinuxI2c::transfer(struct i2c_msg *messages, uint32_t count) {
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = messages;
+    data.nmsgs = count;
+
+    if (transferHook != nullptr) {
+        return transferHook(&data, transferHookContext) >= 0;
+    }
+    if (busFile < 0) {
+        return false;
+    }
+    return ioctl(busFile, I2C_RDWR, &data) >= 0;
+}
+
+void AdsLinuxI2c::beginBatch() {
+    flushBatch();
+    batching = true;
+    batchFailed = false;
+}
+
+bool AdsLinuxI2c::endBatch() {
+    flushBatch();
+    batching = false;
+    return !batchFailed;
+}
+
+bool AdsLinuxI2c::write(byte address, const uint8_t *data, uint16_t length) {
+    if (batching && length <= ADS_LINUX_I2C_BATCH_BYTES) {
+        for (uint16_t i = 0; i < length; i++) {
+            batchData[batchCount][i] = data[i];
+        }
+        struct i2c_msg &message = batchMessages[batchCount];
+        message.addr = address;
+        message.flags = 0;
+        message.len = length;
+        message.buf = batchData[batchCount];
+
+        batchCount++;
+        if (batchCount == I2C_RDWR_IOCTL_MAX_MSGS) {
+            flushBatch();
+        }
+        return true;
+    }
+    flushBatch();
+
+    struct i2c_msg message;
+    message.addr = address;
+    message.flags = 0;
+    message.len = length;
+    message.buf = (uint8_t *)data;
+    return transfer(&message, 1);
+}
+
+bool AdsLinuxI2c::read(byte address, uint8_t *data, uint16_t length) {
+    flushBatch();
+
+    struct i2c_msg message;
+    message.addr = address;
+    message.flags = I2C_M_RD;
+    message.len = length;
+    message.buf = data;
+    return transfer(&message, 1);
+}
+
+bool AdsLinuxI2c::writeRead(byte address, uint8_t reg, uint8_t *data, uint16_t length) {
+    flushBatch();
+
+    struct i2c_msg messages[2];
+    messages[0].addr = address;
+    messages[0].flags = 0;
+    messages[0].len = 1;
+    messages[0].buf = &reg;
+
+    messages[1].addr = address;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len = length;
+    messages[1].buf = data;
+    return transfer(messages, 2);
+}
+
+// MARK: Private methods
+
+void AdsLinuxI2c::flushBatch() {
+    if (batchCount == 0) {
+        return;
+    }
+    if (!transfer(batchMessages, batchCount)) {
+        batchFailed = true;
+    }
+    batchCount = 0;
+}
+
+#endif
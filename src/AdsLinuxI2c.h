@@ -0,0 +1,106 @@
+#ifndef __ADS_LINUX_I2C_H__
+#define __ADS_LINUX_I2C_H__
+
+#include "AdsLinuxPlatform.h"
+
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/// The bus opened by Ads1115Plus::begin() (the header pins i2c bus on Raspberry Pi boards)
+#define ADS_LINUX_DEFAULT_I2C_DEVICE "/dev/i2c-1"
+
+/// The largest write kept in a batch (a register pointer and a 16 bit value)
+#define ADS_LINUX_I2C_BATCH_BYTES 3
+
+/**
+ * Replaces the ioctl(I2C_RDWR) of AdsLinuxI2c::transfer (e.g. with AdsSimulator)
+ * @return 0 on success, -1 when the transfer isn't acknowledged
+ */
+typedef int (*AdsI2cTransferHook)(struct i2c_rdwr_ioctl_data *transfer, void *context);
+
+/**
+ * Access to an i2c bus through the Linux i2c-dev interface (/dev/i2c-N), used by Ads1115Plus on Linux builds
+ * Every transfer is a single ioctl(I2C_RDWR), so a register read (pointer write + read) uses a repeated start
+ * and needs a single system call
+ */
+class AdsLinuxI2c {
+
+private:
+
+    /// The file descriptor of the opened bus (-1 when closed)
+    static int busFile;
+
+    /// When set, transfers are handed to the hook instead of the bus
+    static AdsI2cTransferHook transferHook;
+
+    /// Given to [transferHook]
+    static void *transferHookContext;
+
+    /// True between beginBatch() and endBatch()
+    static bool batching;
+
+    /// The writes waiting in the batch
+    static struct i2c_msg batchMessages[I2C_RDWR_IOCTL_MAX_MSGS];
+
+    /// The data of the writes waiting in the batch
+    static uint8_t batchData[I2C_RDWR_IOCTL_MAX_MSGS][ADS_LINUX_I2C_BATCH_BYTES];
+
+    /// The number of writes waiting in the batch
+    static uint32_t batchCount;
+
+    /// Whether a transfer of the batch wasn't acknowledged
+    static bool batchFailed;
+
+    /// Performs the writes waiting in the batch in a single transfer
+    static void flushBatch();
+
+public:
+
+    /**
+     * Opens the given i2c-dev [devicePath] (closes the bus opened before)
+     * @return false if the device couldn't be opened
+     */
+    static bool open(const char *devicePath);
+
+    /// Closes the bus
+    static void close();
+
+    /// Returns true if a bus is open (or a transfer hook is set)
+    static bool isOpen();
+
+    /**
+     * Hands every transfer to the given [hook] instead of the bus (nullptr to go back to the bus)
+     * Used to run the driver against a simulated bus, see AdsSimulator
+     */
+    static void setTransferHook(AdsI2cTransferHook hook, void *context = nullptr);
+
+    /**
+     * Performs the given messages in a single transfer (repeated starts between them)
+     * @return true if every message was acknowledged
+     */
+    static bool transfer(struct i2c_msg *messages, uint32_t count);
+
+    /**
+     * Starts collecting the writes (up to ADS_LINUX_I2C_BATCH_BYTES each) so they go out in as few transfers as possible,
+     * I2C_RDWR_IOCTL_MAX_MSGS messages per transfer. Reads performed meanwhile send the pending writes first, so the
+     * order of the operations is kept
+     */
+    static void beginBatch();
+
+    /**
+     * Performs the writes still waiting and stops collecting them
+     * @return false if any transfer of the batch wasn't acknowledged (a failed transfer drops the writes following it)
+     */
+    static bool endBatch();
+
+    /// Writes [length] bytes to the device at [address] (queued when batching, the result is then reported by endBatch())
+    static bool write(byte address, const uint8_t *data, uint16_t length);
+
+    /// Reads [length] bytes from the device at [address]
+    static bool read(byte address, uint8_t *data, uint16_t length);
+
+    /// Writes the [reg] pointer and reads [length] bytes back, in a single transfer
+    static bool writeRead(byte address, uint8_t reg, uint8_t *data, uint16_t length);
+};
+
+#endif
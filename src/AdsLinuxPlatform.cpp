@@ -0,0 +1,64 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "Ads1115Plus.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+#include <time.h>
+#include <errno.h>
+
+/// Returns the current CLOCK_MONOTONIC time
+static struct timespec monotonicNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now;
+}
+
+/// Returns the nanoseconds elapsed since the first call to a timing function
+static uint64_t elapsedNanoseconds() {
+    // A function-local static: initialized once even when several threads call micros() first
+    static const struct timespec startTime = monotonicNow();
+    struct timespec now = monotonicNow();
+    return (uint64_t)(now.tv_sec - startTime.tv_sec) * 1000000000ULL + now.tv_nsec - startTime.tv_nsec;
+}
+
+unsigned long micros() {
+    return (uint32_t)(elapsedNanoseconds() / 1000);
+}
+
+unsigned long millis() {
+    return (uint32_t)(elapsedNanoseconds() / 1000000);
+}
+
+void delay(unsigned long milliseconds) {
+    delayMicroseconds(milliseconds * 1000);
+}
+
+void delayMicroseconds(unsigned long microseconds) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += microseconds / 1000000;
+    deadline.tv_nsec += (microseconds % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    // The deadline is absolute, so an interrupted sleep is simply resumed
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+
+#endif
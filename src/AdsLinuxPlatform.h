@@ -0,0 +1,44 @@
+#ifndef __ADS_LINUX_PLATFORM_H__
+#define __ADS_LINUX_PLATFORM_H__
+
+// The subset of the Arduino core used by the library, for Linux builds (see ADS1115PLUS_LINUX_I2C)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+typedef uint8_t byte;
+
+/// Microseconds since the first call to a timing function (CLOCK_MONOTONIC), wraps like the Arduino micros()
+unsigned long micros();
+
+/// Milliseconds since the first call to a timing function (CLOCK_MONOTONIC)
+unsigned long millis();
+
+/// Sleeps for the given milliseconds (clock_nanosleep)
+void delay(unsigned long milliseconds);
+
+/// Sleeps for the given microseconds (clock_nanosleep on an absolute deadline, so signals don't shorten the wait)
+void delayMicroseconds(unsigned long microseconds);
+
+/** Byte output, same role as the Arduino Print (e.g. for AdsRecordEncoder::write) */
+class Print {
+
+public:
+
+    virtual ~Print() {}
+
+    /// Writes a single byte, returns the number of bytes written
+    virtual size_t write(uint8_t value) = 0;
+
+    /// Writes [length] bytes, returns the number of bytes written
+    virtual size_t write(const uint8_t *buffer, size_t length) {
+        size_t written = 0;
+        while (written < length && write(buffer[written]) == 1) {
+            written++;
+        }
+        return written;
+    }
+};
+
+#endif
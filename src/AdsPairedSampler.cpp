@@ -0,0 +1,213 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsPairedSampler.h"
+
+
+AdsPairedSampler::AdsPairedSampler(Ads1115Plus &ads) : ads(ads) {
+    referenceMux = MuxConfig::channel0;
+    referenceGain = AdsGain::twoThirds;
+    otherMux = MuxConfig::channel1;
+    otherGain = AdsGain::twoThirds;
+    speed = AdsSampleSpeed::sps860;
+    running = false;
+    convertingReference = false;
+    conversionStartMicros = 0;
+    otherConversions = 0;
+    lastOtherMicros = 0;
+    lastOtherRaw = 0;
+    olderOtherMicros = 0;
+    olderOtherRaw = 0;
+    quadratic = true;
+    hasReference = false;
+    referenceMicros = 0;
+    referenceRaw = 0;
+    pairCount = 0;
+    pairCallback = nullptr;
+    callbackContext = nullptr;
+}
+
+void AdsPairedSampler::setInputs(MuxConfig referenceMux, AdsGain referenceGain, MuxConfig otherMux, AdsGain otherGain, AdsSampleSpeed speed) {
+    stop();
+    this->referenceMux = referenceMux;
+    this->referenceGain = referenceGain;
+    this->otherMux = otherMux;
+    this->otherGain = otherGain;
+    this->speed = speed;
+}
+
+MuxConfig AdsPairedSampler::getReferenceMux() {
+    return referenceMux;
+}
+
+AdsGain AdsPairedSampler::getReferenceGain() {
+    return referenceGain;
+}
+
+MuxConfig AdsPairedSampler::getOtherMux() {
+    return otherMux;
+}
+
+AdsGain AdsPairedSampler::getOtherGain() {
+    return otherGain;
+}
+
+void AdsPairedSampler::setQuadraticInterpolation(bool enabled) {
+    quadratic = enabled;
+}
+
+void AdsPairedSampler::setPairCallback(AdsPairCallback callback, void *context) {
+    pairCallback = callback;
+    callbackContext = context;
+}
+
+void AdsPairedSampler::start() {
+    otherConversions = 0;
+    hasReference = false;
+    pairCount = 0;
+    running = true;
+
+    // The other input first, so the first reference conversion has one on each side
+    startConversion(false);
+}
+
+void AdsPairedSampler::stop() {
+    running = false;
+    hasReference = false;
+}
+
+bool AdsPairedSampler::isRunning() {
+    return running;
+}
+
+bool AdsPairedSampler::poll() {
+    if (!running) {
+        return false;
+    }
+
+    // The nominal conversion time first, then the OS bit until the conversion time with its tolerance is over
+    uint32_t elapsed = micros() - conversionStartMicros;
+    if (elapsed < Ads1115Plus::samplePeriodMicros(speed)) {
+        return false;
+    }
+    if (elapsed < Ads1115Plus::conversionTimeMicros(speed) && !ads.isConversionReady()) {
+        return false;
+    }
+    return finishConversion();
+}
+
+uint32_t AdsPairedSampler::microsUntilNextEvent() {
+    if (!running) {
+        return 0xFFFFFFFF;
+    }
+
+    uint32_t elapsed = micros() - conversionStartMicros;
+    uint32_t period = Ads1115Plus::samplePeriodMicros(speed);
+    return elapsed >= period ? 0 : period - elapsed;
+}
+
+uint32_t AdsPairedSampler::getPairCount() {
+    return pairCount;
+}
+
+unsigned long AdsPairedSampler::pairPeriodMicros() {
+    return 2 * Ads1115Plus::samplePeriodMicros(speed);
+}
+
+// MARK: Private methods
+
+void AdsPairedSampler::startConversion(bool reference) {
+    ads.setGain(reference ? referenceGain : otherGain, false);
+    ads.setSampleSpeed(speed, false);
+    ads.startSingleShotOnMux(reference ? referenceMux : otherMux);
+
+    // The config is latched at the end of the write, the conversion starts then
+    conversionStartMicros = micros();
+    convertingReference = reference;
+}
+
+bool AdsPairedSampler::finishConversion() {
+    int16_t raw = ads.getLastConversionResults();
+    uint32_t middleMicros = conversionStartMicros + Ads1115Plus::samplePeriodMicros(speed) / 2;
+    bool reference = convertingReference;
+
+    // Keep the conversions back to back
+    startConversion(!reference);
+
+    if (reference) {
+        hasReference = otherConversions > 0;
+        referenceMicros = middleMicros;
+        referenceRaw = raw;
+        return false;
+    }
+
+    bool produced = false;
+    if (hasReference) {
+        AdsSamplePair pair;
+        pair.timestampMicros = referenceMicros;
+        pair.referenceRaw = referenceRaw;
+        pair.spanMicros = middleMicros - lastOtherMicros;
+
+        pair.otherRaw = interpolate(referenceMicros, middleMicros, raw);
+        hasReference = false;
+        pairCount++;
+        produced = true;
+        if (pairCallback != nullptr) {
+            pairCallback(pair, callbackContext);
+        }
+    }
+
+    otherConversions++;
+    olderOtherMicros = lastOtherMicros;
+    olderOtherRaw = lastOtherRaw;
+    lastOtherMicros = middleMicros;
+    lastOtherRaw = raw;
+    return produced;
+}
+
+int16_t AdsPairedSampler::interpolate(uint32_t timeMicros, uint32_t afterMicros, int16_t afterRaw) {
+    // The times relative to [timeMicros]: older < before < 0 < after
+    int32_t older = (int32_t)(olderOtherMicros - timeMicros);
+    int32_t before = (int32_t)(lastOtherMicros - timeMicros);
+    int32_t after = (int32_t)(afterMicros - timeMicros);
+    int64_t value;
+
+    if (quadratic && otherConversions >= 2) {
+        // Scaled down to 12 bits, so the products below fit in 64 bits whatever the sample speed
+        while (after - older >= 4096) {
+            older >>= 1;
+            before >>= 1;
+            after >>= 1;
+        }
+    }
+
+    if (quadratic && otherConversions >= 2 && older < before && before < after) {
+        // Newton form of the parabola through the three conversions, over a common denominator
+        int64_t rise = (int64_t)afterRaw - lastOtherRaw;
+        int64_t previousRise = (int64_t)lastOtherRaw - olderOtherRaw;
+        int64_t numerator = rise * -before * (before - older) * (after - older)
+            + (rise * (before - older) - previousRise * (after - before)) * before * after;
+        int64_t denominator = (int64_t)(after - before) * (before - older) * (after - older);
+        value = lastOtherRaw + (numerator >= 0 ? numerator + denominator / 2 : numerator - denominator / 2) / denominator;
+    } else if (before < after) {
+        // Linear between the conversions before and after
+        int64_t step = ((int64_t)afterRaw - lastOtherRaw) * -before;
+        int32_t span = after - before;
+        value = lastOtherRaw + (step >= 0 ? step + span / 2 : step - span / 2) / span;
+    } else {
+        value = afterRaw;
+    }
+
+    return value > 32767 ? 32767 : (value < -32768 ? -32768 : (int16_t)value);
+}
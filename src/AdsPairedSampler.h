@@ -0,0 +1,180 @@
+#ifndef __ADS_PAIRED_SAMPLER_H__
+#define __ADS_PAIRED_SAMPLER_H__
+
+#include "Ads1115Plus.h"
+
+/** Two inputs aligned on the same instant, produced by an AdsPairedSampler */
+struct AdsSamplePair {
+
+    /// The middle of the conversion of the reference input (micros())
+    uint32_t timestampMicros;
+
+    /// The raw value of the reference input
+    int16_t referenceRaw;
+
+    /// The raw value of the other input at [timestampMicros], interpolated from its conversions around it
+    int16_t otherRaw;
+
+    /// The time between the two conversions of the other input used for the interpolation
+    uint32_t spanMicros;
+};
+
+/// Called with each pair produced by an AdsPairedSampler
+typedef void (*AdsPairCallback)(const AdsSamplePair &pair, void *context);
+
+/**
+ * Reads two inputs of a device alternately, as fast as the device allows, and aligns them in time
+ *
+ * The mux converts a single input at a time, so derived quantities (e.g. the power from a shunt on a differential
+ * input and a voltage on a single ended one) computed from two consecutive reads mix two different instants.
+ * Here the conversions alternate other, reference, other, reference... and each one is timestamped at its middle
+ * (the ADS1115 averages the input over the whole conversion). The other input is interpolated (integer math) to the
+ * middle of each reference conversion, so the pairs stay aligned for signals well below half the pair rate.
+ *
+ * A pair is produced once the conversion of the other input after the reference one is done (one conversion of latency).
+ * The next conversion is started as soon as the previous one is read (isConversionReady() is polled once the nominal
+ * conversion time has elapsed), poll() never blocks.
+ */
+class AdsPairedSampler {
+
+private:
+
+    /// The device read
+    Ads1115Plus &ads;
+
+    /// The input the pairs are timed on
+    MuxConfig referenceMux;
+
+    /// The gain of the reference input
+    AdsGain referenceGain;
+
+    /// The input interpolated on the reference one
+    MuxConfig otherMux;
+
+    /// The gain of the other input
+    AdsGain otherGain;
+
+    /// The sample speed of both inputs
+    AdsSampleSpeed speed;
+
+    /// True between start() and stop()
+    bool running;
+
+    /// True while the conversion being performed is of the reference input
+    bool convertingReference;
+
+    /// The micros() when the conversion being performed was started
+    uint32_t conversionStartMicros;
+
+    /// The number of conversions of the other input read since start()
+    uint32_t otherConversions;
+
+    /// The middle of the last conversion of the other input
+    uint32_t lastOtherMicros;
+
+    /// The last conversion of the other input
+    int16_t lastOtherRaw;
+
+    /// The middle of the conversion of the other input before the last one
+    uint32_t olderOtherMicros;
+
+    /// The conversion of the other input before the last one
+    int16_t olderOtherRaw;
+
+    /// Whether the other input is interpolated with a parabola through three conversions (or a line through two)
+    bool quadratic;
+
+    /// True when a reference conversion waits for the next conversion of the other input
+    bool hasReference;
+
+    /// The middle of the pending reference conversion
+    uint32_t referenceMicros;
+
+    /// The pending reference conversion
+    int16_t referenceRaw;
+
+    /// The number of pairs produced since start()
+    uint32_t pairCount;
+
+    /// Called with each pair
+    AdsPairCallback pairCallback;
+
+    /// Given to [pairCallback]
+    void *callbackContext;
+
+    /// Starts the conversion of the reference input or of the other one
+    void startConversion(bool reference);
+
+    /// Reads the finished conversion, produces the pair when complete
+    bool finishConversion();
+
+    /// Returns the other input at [timeMicros] from its last conversions and the one just read ([afterMicros], [afterRaw])
+    int16_t interpolate(uint32_t timeMicros, uint32_t afterMicros, int16_t afterRaw);
+
+public:
+
+    /// Creates a sampler for the given device, reading channel 0 and 1 at 860 SPS until setInputs() is called
+    AdsPairedSampler(Ads1115Plus &ads);
+
+    /**
+     * Sets the two inputs read (stops the sampler)
+     * @param referenceMux The input whose conversion times are the times of the pairs
+     * @param otherMux The input interpolated to the times of the reference one
+     * @param speed The sample speed of both inputs, the pairs are produced at half its rate
+     */
+    void setInputs(MuxConfig referenceMux, AdsGain referenceGain, MuxConfig otherMux, AdsGain otherGain, AdsSampleSpeed speed = AdsSampleSpeed::sps860);
+
+    /// Returns the input the pairs are timed on
+    MuxConfig getReferenceMux();
+
+    /// Returns the gain of the reference input
+    AdsGain getReferenceGain();
+
+    /// Returns the input interpolated on the reference one
+    MuxConfig getOtherMux();
+
+    /// Returns the gain of the other input
+    AdsGain getOtherGain();
+
+    /**
+     * Selects how the other input is interpolated (quadratic by default)
+     * @param enabled true for a parabola through the two conversions around the reference one and the one before,
+     * false for a line through the two conversions around it (the line flattens the peaks of signals close to the pair rate)
+     */
+    void setQuadraticInterpolation(bool enabled);
+
+    /**
+     * Sets the function called with each pair (from poll())
+     * @param context Given back to the [callback]
+     */
+    void setPairCallback(AdsPairCallback callback, void *context = nullptr);
+
+    /// Starts the conversions
+    void start();
+
+    /// Stops the conversions, a conversion being performed and a pending reference conversion are discarded
+    void stop();
+
+    /// Returns true between start() and stop()
+    bool isRunning();
+
+    /**
+     * Reads the finished conversion and starts the next one
+     * @return true if a pair was produced (and handed to the callback)
+     */
+    bool poll();
+
+    /**
+     * Returns the time in microseconds until poll() has something to do (0 if it is due now)
+     * Use it to sleep between polls, returns 0xFFFFFFFF when stopped
+     */
+    uint32_t microsUntilNextEvent();
+
+    /// Returns the number of pairs produced since start()
+    uint32_t getPairCount();
+
+    /// Returns the nominal time between two pairs (two conversions)
+    unsigned long pairPeriodMicros();
+};
+
+#endif
@@ -0,0 +1,151 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsRateOptimizer.h"
+
+
+AdsRateOptimizer::AdsRateOptimizer(AdsScanner &scanner) : scanner(scanner) {
+    characterized = false;
+}
+
+void AdsRateOptimizer::characterize(byte samples) {
+    if (samples < 2) {
+        samples = 2;
+    }
+
+    Ads1115Plus &ads = scanner.device();
+    AdsGain previousGain = ads.getGain();
+    AdsSampleSpeed previousSpeed = ads.getSampleSpeed();
+
+    for (byte slotIndex = 0; slotIndex < scanner.getSlotCount(); slotIndex++) {
+        const AdsScanSlot &slot = scanner.slot(slotIndex);
+        ads.setGain(slot.gain, false);
+
+        for (byte speedIndex = 0; speedIndex < ADS_SAMPLE_SPEED_COUNT; speedIndex++) {
+            ads.setSampleSpeed(speedOf(speedIndex), false);
+
+            // Discard the first conversion after changing the configuration
+            ads.readRawOnMux(slot.mux);
+
+            // Deviations from the first reading keep the sums small (this isn't a fast path, doubles are fine)
+            int16_t reference = ads.readRawOnMux(slot.mux);
+            double sum = 0;
+            double sumSquares = 0;
+            for (byte i = 1; i < samples; i++) {
+                double deviation = ads.readRawOnMux(slot.mux) - reference;
+                sum += deviation;
+                sumSquares += deviation * deviation;
+            }
+
+            double mean = sum / samples;
+            double variance = sumSquares / samples - mean * mean;
+            double deviation = variance > 0 ? sqrt(variance) * 16 : 0;
+            noise[slotIndex][speedIndex] = deviation > 0xFFFF ? 0xFFFF : (uint16_t)(deviation + 0.5);
+        }
+    }
+
+    ads.setGain(previousGain, false);
+    ads.setSampleSpeed(previousSpeed, false);
+    characterized = true;
+}
+
+bool AdsRateOptimizer::isCharacterized() {
+    return characterized;
+}
+
+double AdsRateOptimizer::noiseMicrovolts(byte slotIndex, AdsSampleSpeed speed) {
+    if (!characterized || slotIndex >= scanner.getSlotCount()) {
+        return 0;
+    }
+    AdsGain gain = scanner.slot(slotIndex).gain;
+    double microvoltsPerRawValue = (double)Ads1115Plus::microvoltsMultiplier(gain) / ((uint32_t)1 << Ads1115Plus::microvoltsShift(gain));
+    return noise[slotIndex][(uint16_t)speed >> 5] * microvoltsPerRawValue / 16;
+}
+
+bool AdsRateOptimizer::selectForNoise(uint32_t targetNanovolts) {
+    if (!characterized) {
+        return false;
+    }
+
+    bool allMeetTarget = true;
+    for (byte slotIndex = 0; slotIndex < scanner.getSlotCount(); slotIndex++) {
+
+        // Start from the fastest speed, sps8 is kept when none meets the target
+        byte chosen = 0;
+        bool meetsTarget = false;
+        for (int speedIndex = ADS_SAMPLE_SPEED_COUNT - 1; speedIndex >= 0; speedIndex--) {
+            if (noiseMicrovolts(slotIndex, speedOf(speedIndex)) * 1000 <= targetNanovolts) {
+                chosen = speedIndex;
+                meetsTarget = true;
+                break;
+            }
+        }
+
+        scanner.slot(slotIndex).speed = speedOf(chosen);
+        allMeetTarget = allMeetTarget && meetsTarget;
+    }
+    return allMeetTarget;
+}
+
+unsigned long AdsRateOptimizer::selectForTimeBudget(unsigned long budgetMicros) {
+    byte slotCount = scanner.getSlotCount();
+    byte speedIndexes[ADS_MAX_SCAN_SLOTS];
+
+    // Start with every slot at the fastest speed
+    unsigned long total = 0;
+    for (byte slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+        speedIndexes[slotIndex] = ADS_SAMPLE_SPEED_COUNT - 1;
+        total += Ads1115Plus::conversionTimeMicros(speedOf(speedIndexes[slotIndex]));
+    }
+
+    // Slow down the noisiest slot that still fits the budget, one step at a time
+    while (characterized) {
+        // Slots without measurable noise aren't slowed down
+        int noisiestSlot = -1;
+        double noisiest = 0;
+        unsigned long noisiestTotal = 0;
+
+        for (byte slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+            byte speedIndex = speedIndexes[slotIndex];
+            if (speedIndex == 0) {
+                continue;
+            }
+
+            unsigned long slowerTotal = total - Ads1115Plus::conversionTimeMicros(speedOf(speedIndex)) + Ads1115Plus::conversionTimeMicros(speedOf(speedIndex - 1));
+            double slotNoise = noiseMicrovolts(slotIndex, speedOf(speedIndex));
+            if (slowerTotal <= budgetMicros && slotNoise > noisiest) {
+                noisiestSlot = slotIndex;
+                noisiest = slotNoise;
+                noisiestTotal = slowerTotal;
+            }
+        }
+
+        if (noisiestSlot < 0) {
+            break;
+        }
+        speedIndexes[noisiestSlot]--;
+        total = noisiestTotal;
+    }
+
+    for (byte slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+        scanner.slot(slotIndex).speed = speedOf(speedIndexes[slotIndex]);
+    }
+    return total;
+}
+
+// MARK: Private methods
+
+AdsSampleSpeed AdsRateOptimizer::speedOf(byte index) {
+    return (AdsSampleSpeed)((uint16_t)(index & 0x7) << 5);
+}
@@ -0,0 +1,70 @@
+#ifndef __ADS_RATE_OPTIMIZER_H__
+#define __ADS_RATE_OPTIMIZER_H__
+
+#include "Ads1115Plus.h"
+#include "AdsScanner.h"
+
+/// The number of sample speeds (see AdsSampleSpeed)
+#define ADS_SAMPLE_SPEED_COUNT 8
+
+/// The default number of readings used to measure the noise at each sample speed
+#define ADS_DEFAULT_NOISE_SAMPLES 16
+
+/**
+ * Picks the sample speed of each slot of an AdsScanner, trading noise for conversion time
+ *
+ * characterize() measures the noise (standard deviation) of each slot at the eight sample speeds, the inputs have to be
+ * steady during the measurement. Then one of the select methods writes the chosen speeds into the scanner slots:
+ * - selectForNoise() picks the fastest speed that meets a noise target on every slot
+ * - selectForTimeBudget() picks the quietest speeds whose conversions fit a time budget for the whole scan list
+ */
+class AdsRateOptimizer {
+
+private:
+
+    /// The scanner whose slots are characterized and configured
+    AdsScanner &scanner;
+
+    /// The measured noise of each slot at each speed, in raw values * 16 (indexed by [slot][speed index])
+    uint16_t noise[ADS_MAX_SCAN_SLOTS][ADS_SAMPLE_SPEED_COUNT];
+
+    /// Whether characterize() has been run (run it again after changing the scan list)
+    bool characterized;
+
+    /// Returns the sample speed for the given [index] (0 is sps8, 7 is sps860)
+    static AdsSampleSpeed speedOf(byte index);
+
+public:
+
+    /// Creates an optimizer for the slots of the given [scanner]
+    AdsRateOptimizer(AdsScanner &scanner);
+
+    /**
+     * Measures the noise of every slot at the eight sample speeds (blocking, the scanner has to be stopped)
+     * With the default 16 samples it takes about 4.5s per slot, mostly spent on the slowest speeds
+     * @param samples The number of readings used at each speed (at least 2)
+     */
+    void characterize(byte samples = ADS_DEFAULT_NOISE_SAMPLES);
+
+    /// Returns whether characterize() has been run
+    bool isCharacterized();
+
+    /// Returns the measured noise (standard deviation) of the slot at [slotIndex] with the given [speed] in microvolts
+    double noiseMicrovolts(byte slotIndex, AdsSampleSpeed speed);
+
+    /**
+     * Sets every slot to the fastest speed whose noise is below [targetNanovolts]
+     * Slots that can't meet the target are set to the quietest speed
+     * @return true if every slot meets the target (false as well if not characterized)
+     */
+    bool selectForNoise(uint32_t targetNanovolts);
+
+    /**
+     * Sets the slot speeds so the conversion times of the whole scan list fit [budgetMicros] with the lowest noise
+     * Starting from the fastest speeds, the noisiest slot is slowed down one step at a time while the budget allows it
+     * @return The total conversion time of the scan list with the chosen speeds (larger than the budget when even the fastest speeds don't fit)
+     */
+    unsigned long selectForTimeBudget(unsigned long budgetMicros);
+};
+
+#endif
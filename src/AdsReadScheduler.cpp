@@ -0,0 +1,251 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsReadScheduler.h"
+
+
+AdsReadScheduler::AdsReadScheduler() {
+    for (byte i = 0; i < ADS_MAX_SCHEDULER_DEVICES; i++) {
+        lanes[i].ads = nullptr;
+        lanes[i].head = nullptr;
+        lanes[i].tail = nullptr;
+        lanes[i].converting = nullptr;
+        lanes[i].conversionStartMicros = 0;
+        lanes[i].conversionTimeMicros = 0;
+    }
+    pendingReads = 0;
+    conversions = 0;
+}
+
+bool AdsReadScheduler::submit(AdsReadRequest &request) {
+    Lane *lane = laneOf(request.ads);
+    if (lane == nullptr) {
+        return false;
+    }
+
+    request.next = nullptr;
+    if (lane->tail == nullptr) {
+        lane->head = &request;
+    } else {
+        lane->tail->next = &request;
+    }
+    lane->tail = &request;
+    pendingReads++;
+
+    // An idle device starts right away, otherwise the read is started by poll() once the device is free
+    if (lane->converting == nullptr) {
+        startConversion(*lane, micros());
+    }
+    return true;
+}
+
+bool AdsReadScheduler::submit(AdsReadRequest &request, Ads1115Plus &ads, MuxConfig mux, AdsSampleCallback callback, void *context) {
+    request.ads = &ads;
+    request.mux = mux;
+    request.gain = ads.getGain();
+    request.speed = ads.getSampleSpeed();
+    request.callback = callback;
+    request.context = context;
+    return submit(request);
+}
+
+bool AdsReadScheduler::poll() {
+    bool completed = false;
+    uint32_t now = micros();
+
+    for (byte i = 0; i < ADS_MAX_SCHEDULER_DEVICES; i++) {
+        Lane &lane = lanes[i];
+        if (lane.converting == nullptr || now - lane.conversionStartMicros < lane.conversionTimeMicros) {
+            continue;
+        }
+
+        finishConversion(lane);
+        completed = true;
+
+        // The callbacks may have queued more reads
+        if (lane.head != nullptr) {
+            startConversion(lane, micros());
+        } else {
+            lane.ads = nullptr;
+        }
+    }
+    return completed;
+}
+
+uint32_t AdsReadScheduler::microsUntilNextEvent() {
+    uint32_t next = 0xFFFFFFFF;
+    uint32_t now = micros();
+
+    for (byte i = 0; i < ADS_MAX_SCHEDULER_DEVICES; i++) {
+        const Lane &lane = lanes[i];
+        if (lane.converting == nullptr) {
+            continue;
+        }
+        uint32_t elapsed = now - lane.conversionStartMicros;
+        if (elapsed >= lane.conversionTimeMicros) {
+            return 0;
+        }
+        if (lane.conversionTimeMicros - elapsed < next) {
+            next = lane.conversionTimeMicros - elapsed;
+        }
+    }
+    return next;
+}
+
+void AdsReadScheduler::run() {
+    while (pendingReads > 0) {
+        poll();
+
+        uint32_t wait = microsUntilNextEvent();
+        if (wait == 0 || wait == 0xFFFFFFFF) {
+            continue;
+        }
+        if (wait >= 1000) {
+            delay(wait / 1000);
+        }
+        delayMicroseconds(wait % 1000);
+    }
+}
+
+uint32_t AdsReadScheduler::getPendingReads() {
+    return pendingReads;
+}
+
+uint32_t AdsReadScheduler::getConversionCount() {
+    return conversions;
+}
+
+#if defined(ADS_READ_SCHEDULER_COROUTINES)
+AdsReadAwaiter AdsReadScheduler::read(Ads1115Plus &ads, MuxConfig mux) {
+    return AdsReadAwaiter(*this, ads, mux);
+}
+#endif
+
+// MARK: Private methods
+
+AdsReadScheduler::Lane *AdsReadScheduler::laneOf(Ads1115Plus *ads) {
+    Lane *freeLane = nullptr;
+    for (byte i = 0; i < ADS_MAX_SCHEDULER_DEVICES; i++) {
+        if (lanes[i].ads == ads) {
+            return &lanes[i];
+        }
+        if (lanes[i].ads == nullptr && freeLane == nullptr) {
+            freeLane = &lanes[i];
+        }
+    }
+    if (freeLane != nullptr) {
+        freeLane->ads = ads;
+    }
+    return freeLane;
+}
+
+void AdsReadScheduler::startConversion(Lane &lane, uint32_t now) {
+    AdsReadRequest *first = lane.head;
+
+    // Move the first read, and the waiting reads sharing its config, to the conversion
+    AdsReadRequest *servedTail = first;
+    lane.head = first->next;
+    if (lane.head == nullptr) {
+        lane.tail = nullptr;
+    }
+
+    AdsReadRequest *previous = nullptr;
+    AdsReadRequest *request = lane.head;
+    while (request != nullptr) {
+        AdsReadRequest *following = request->next;
+        if (request->mux == first->mux && request->gain == first->gain && request->speed == first->speed) {
+            if (previous == nullptr) {
+                lane.head = following;
+            } else {
+                previous->next = following;
+            }
+            if (lane.tail == request) {
+                lane.tail = previous;
+            }
+            servedTail->next = request;
+            servedTail = request;
+        } else {
+            previous = request;
+        }
+        request = following;
+    }
+    servedTail->next = nullptr;
+
+    lane.converting = first;
+    lane.conversionStartMicros = now;
+    lane.conversionTimeMicros = Ads1115Plus::conversionTimeMicros(first->speed);
+
+    Ads1115Plus &ads = *lane.ads;
+    ads.setGain(first->gain, false);
+    ads.setSampleSpeed(first->speed, false);
+    ads.startSingleShotOnMux(first->mux);
+    conversions++;
+}
+
+void AdsReadScheduler::finishConversion(Lane &lane) {
+    AdsReadRequest *served = lane.converting;
+
+    AdsSample sample;
+    sample.raw = lane.ads->getLastConversionResults();
+    sample.timestampMicros = lane.conversionStartMicros;
+    sample.device = (byte)lane.ads->getAddress() - (byte)AdsAddress::gnd;
+    sample.mux = served->mux;
+    sample.gain = served->gain;
+
+    while (served != nullptr) {
+        // The callback may free the request (e.g. a coroutine frame), so it isn't touched after the call
+        AdsReadRequest *next = served->next;
+        AdsSampleCallback callback = served->callback;
+        void *context = served->context;
+        pendingReads--;
+        if (callback != nullptr) {
+            callback(sample, context);
+        }
+        served = next;
+    }
+
+    // Cleared last, so the reads submitted by the callbacks are queued rather than started in between
+    lane.converting = nullptr;
+}
+
+// MARK: Coroutines
+
+#if defined(ADS_READ_SCHEDULER_COROUTINES)
+AdsReadAwaiter::AdsReadAwaiter(AdsReadScheduler &scheduler, Ads1115Plus &ads, MuxConfig mux) : scheduler(scheduler) {
+    request.ads = &ads;
+    request.mux = mux;
+    request.gain = ads.getGain();
+    request.speed = ads.getSampleSpeed();
+    request.callback = resume;
+    request.context = this;
+    request.next = nullptr;
+
+    sample.raw = 0;
+    sample.timestampMicros = 0;
+    sample.device = (byte)ads.getAddress() - (byte)AdsAddress::gnd;
+    sample.mux = mux;
+    sample.gain = request.gain;
+}
+
+bool AdsReadAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    this->handle = handle;
+    return scheduler.submit(request);
+}
+
+void AdsReadAwaiter::resume(const AdsSample &sample, void *awaiter) {
+    AdsReadAwaiter *self = (AdsReadAwaiter *)awaiter;
+    self->sample = sample;
+    self->handle.resume();
+}
+#endif
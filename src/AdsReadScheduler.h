@@ -0,0 +1,203 @@
+#ifndef __ADS_READ_SCHEDULER_H__
+#define __ADS_READ_SCHEDULER_H__
+
+#include "Ads1115Plus.h"
+#include "AdsScanner.h"
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <exception>
+#define ADS_READ_SCHEDULER_COROUTINES
+#endif
+
+/// The maximum number of devices served by an AdsReadScheduler
+#define ADS_MAX_SCHEDULER_DEVICES 8
+
+/**
+ * A read waiting in an AdsReadScheduler, owned by the caller (the scheduler doesn't allocate)
+ * It must stay alive and untouched until its callback is called
+ */
+struct AdsReadRequest {
+
+    /// The device read
+    Ads1115Plus *ads;
+
+    /// The channel (single or differential) read
+    MuxConfig mux;
+
+    /// The gain used for the conversion
+    AdsGain gain;
+
+    /// The sample speed used for the conversion
+    AdsSampleSpeed speed;
+
+    /// Called with the sample once the conversion is read
+    AdsSampleCallback callback;
+
+    /// Given to [callback]
+    void *context;
+
+    /// The next request of the same device (used by the scheduler)
+    AdsReadRequest *next;
+};
+
+#if defined(ADS_READ_SCHEDULER_COROUTINES)
+class AdsReadAwaiter;
+#endif
+
+/**
+ * Serves non-blocking reads of many devices from a single thread (or loop())
+ *
+ * Each device performs one conversion at a time, its reads wait in a FIFO queue. A conversion is started with
+ * startSingleShotOnMux() and read once conversionTimeMicros() have elapsed, nothing blocks in between:
+ * - Call poll() whenever microsUntilNextEvent() elapses, or run() to sleep between the events until every read is done
+ * - Reads of the same device, mux, gain and speed waiting when a conversion starts share that conversion
+ * - Callbacks (and resumed coroutines) may submit new reads
+ *
+ * The scheduler is not thread safe, submit reads from the thread that polls it.
+ * With C++20 coroutines a read can be awaited: AdsSample sample = co_await scheduler.read(ads, MuxConfig::channel2);
+ */
+class AdsReadScheduler {
+
+private:
+
+    /** The reads of a device */
+    struct Lane {
+
+        /// The device, nullptr when the lane is free
+        Ads1115Plus *ads;
+
+        /// The first read waiting for a conversion
+        AdsReadRequest *head;
+
+        /// The last read waiting for a conversion
+        AdsReadRequest *tail;
+
+        /// The reads served by the conversion being performed (nullptr when idle)
+        AdsReadRequest *converting;
+
+        /// The time the conversion being performed was started
+        uint32_t conversionStartMicros;
+
+        /// The time the conversion being performed takes
+        uint32_t conversionTimeMicros;
+    };
+
+    /// The devices with pending reads
+    Lane lanes[ADS_MAX_SCHEDULER_DEVICES];
+
+    /// The number of reads submitted and not completed
+    uint32_t pendingReads;
+
+    /// The number of conversions performed
+    uint32_t conversions;
+
+    /// Returns the lane of the given device (a free one if it has none), nullptr when every lane is taken
+    Lane *laneOf(Ads1115Plus *ads);
+
+    /// Starts the conversion of the first read of the [lane], along with the waiting reads sharing its config
+    void startConversion(Lane &lane, uint32_t now);
+
+    /// Reads the conversion of the [lane] and calls the callbacks of the reads it serves
+    void finishConversion(Lane &lane);
+
+public:
+
+    /// Creates a scheduler with no pending reads
+    AdsReadScheduler();
+
+    /**
+     * Queues the given [request] (its fields must be set, see the other submit())
+     * @return false if ADS_MAX_SCHEDULER_DEVICES other devices already have pending reads
+     */
+    bool submit(AdsReadRequest &request);
+
+    /**
+     * Queues a read of [mux] on [ads] with the current gain and sample speed of the device
+     * @param request Filled and kept by the scheduler until the [callback] is called
+     * @param context Given back to the [callback]
+     * @return false if ADS_MAX_SCHEDULER_DEVICES other devices already have pending reads
+     */
+    bool submit(AdsReadRequest &request, Ads1115Plus &ads, MuxConfig mux, AdsSampleCallback callback, void *context = nullptr);
+
+    /**
+     * Reads the finished conversions and starts the next ones, never blocks
+     * @return true if any read was completed
+     */
+    bool poll();
+
+    /// Returns the time in microseconds until poll() has something to do (0 if it is due now, 0xFFFFFFFF without pending reads)
+    uint32_t microsUntilNextEvent();
+
+    /// Polls and sleeps until every pending read (including the ones submitted meanwhile) is completed
+    void run();
+
+    /// Returns the number of reads submitted and not completed yet
+    uint32_t getPendingReads();
+
+    /// Returns the number of conversions performed (lower than the number of reads when reads share conversions)
+    uint32_t getConversionCount();
+
+#if defined(ADS_READ_SCHEDULER_COROUTINES)
+    /// Returns an awaitable read of [mux] on [ads] with the current gain and sample speed of the device
+    AdsReadAwaiter read(Ads1115Plus &ads, MuxConfig mux);
+#endif
+};
+
+#if defined(ADS_READ_SCHEDULER_COROUTINES)
+/**
+ * Suspends the awaiting coroutine until the read is completed, then resumes it (from AdsReadScheduler::poll())
+ * The request lives in the coroutine frame, so a pending read costs no allocation
+ */
+class AdsReadAwaiter {
+
+private:
+
+    /// The scheduler serving the read
+    AdsReadScheduler &scheduler;
+
+    /// The read submitted on suspension
+    AdsReadRequest request;
+
+    /// The coroutine resumed once the read is completed
+    std::coroutine_handle<> handle;
+
+    /// The sample read
+    AdsSample sample;
+
+    /// The request callback, resumes the coroutine
+    static void resume(const AdsSample &sample, void *awaiter);
+
+public:
+
+    /// Creates an awaitable read of [mux] on [ads]
+    AdsReadAwaiter(AdsReadScheduler &scheduler, Ads1115Plus &ads, MuxConfig mux);
+
+    /// Always suspends
+    bool await_ready() { return false; }
+
+    /// Submits the read, the coroutine isn't suspended when it can't be submitted (the sample is then invalid, see await_resume())
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    /// Returns the sample read (with a timestamp of 0 and a raw value of 0 when the read couldn't be submitted)
+    AdsSample await_resume() { return sample; }
+};
+
+/**
+ * A coroutine started right away and never awaited, its frame is freed when it returns
+ * e.g. AdsAsyncTask sensorLoop(AdsReadScheduler &scheduler, Ads1115Plus &ads) { ... co_await scheduler.read(...); ... }
+ */
+struct AdsAsyncTask {
+
+    /** The coroutine promise */
+    struct promise_type {
+        AdsAsyncTask get_return_object() { return AdsAsyncTask(); }
+        std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+        std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+#endif
+
+#endif
@@ -0,0 +1,169 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsSampleRecord.h"
+
+
+AdsRecordEncoder::AdsRecordEncoder(uint16_t timeInterval) {
+    this->timeInterval = timeInterval;
+    reset();
+}
+
+void AdsRecordEncoder::reset() {
+    lastTimestamp = 0;
+    framesSinceTime = 0;
+    needsTime = true;
+}
+
+size_t AdsRecordEncoder::encode(const AdsSample &sample, uint8_t *buffer) {
+    size_t position = 0;
+    uint32_t delta = sample.timestampMicros - lastTimestamp;
+
+    if (needsTime || delta > 0xFFFF || (timeInterval != 0 && framesSinceTime >= timeInterval)) {
+        uint32_t timestamp = sample.timestampMicros;
+        buffer[position++] = ADS_RECORD_TIME_SYNC;
+        buffer[position++] = timestamp & 0xFF;
+        buffer[position++] = (timestamp >> 8) & 0xFF;
+        buffer[position++] = (timestamp >> 16) & 0xFF;
+        buffer[position++] = (timestamp >> 24) & 0xFF;
+        buffer[position] = crc8(buffer + position - 4, 4);
+        position++;
+
+        delta = 0;
+        framesSinceTime = 0;
+        needsTime = false;
+    }
+
+    size_t frameStart = position;
+    uint16_t raw = (uint16_t)sample.raw;
+    buffer[position++] = ADS_RECORD_SAMPLE_SYNC;
+    buffer[position++] = ((sample.device & 0x3) << 6) | (Ads1115Plus::muxIndex(sample.mux) << 3) | Ads1115Plus::gainIndex(sample.gain);
+    buffer[position++] = delta & 0xFF;
+    buffer[position++] = delta >> 8;
+    buffer[position++] = raw & 0xFF;
+    buffer[position++] = raw >> 8;
+    buffer[position] = crc8(buffer + frameStart + 1, ADS_RECORD_SAMPLE_SIZE - 2);
+    position++;
+
+    lastTimestamp = sample.timestampMicros;
+    framesSinceTime++;
+    return position;
+}
+
+size_t AdsRecordEncoder::write(Print &output, const AdsSample &sample) {
+    uint8_t buffer[ADS_RECORD_MAX_SIZE];
+    size_t length = encode(sample, buffer);
+    return output.write(buffer, length);
+}
+
+uint8_t AdsRecordEncoder::crc8(const uint8_t *data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (byte bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// MARK: Decoder
+
+AdsRecordDecoder::AdsRecordDecoder() {
+    droppedFrames = 0;
+    reset();
+}
+
+void AdsRecordDecoder::reset() {
+    frameLength = 0;
+    lastTimestamp = 0;
+    timeSynced = false;
+}
+
+bool AdsRecordDecoder::feed(uint8_t value, AdsSample &sample) {
+    if (frameLength == 0 && frameSizeOf(value) == 0) {
+        return false; // Wait for a sync byte
+    }
+    frame[frameLength++] = value;
+
+    // A dropped frame may leave a complete frame behind, hence the loop
+    while (frameLength > 0 && frameLength >= frameSizeOf(frame[0])) {
+        byte size = frameSizeOf(frame[0]);
+        if (crc8Matches(size)) {
+            bool isSample = decodeFrame(sample);
+            frameLength = 0;
+            return isSample;
+        }
+
+        droppedFrames++;
+        timeSynced = false;
+        resync();
+    }
+    return false;
+}
+
+bool AdsRecordDecoder::isTimeSynced() {
+    return timeSynced;
+}
+
+uint32_t AdsRecordDecoder::getDroppedFrames() {
+    return droppedFrames;
+}
+
+// MARK: Private methods
+
+byte AdsRecordDecoder::frameSizeOf(uint8_t sync) {
+    switch (sync) {
+    case ADS_RECORD_SAMPLE_SYNC:
+        return ADS_RECORD_SAMPLE_SIZE;
+    case ADS_RECORD_TIME_SYNC:
+        return ADS_RECORD_TIME_SIZE;
+    default:
+        return 0;
+    }
+}
+
+bool AdsRecordDecoder::crc8Matches(byte size) {
+    return AdsRecordEncoder::crc8(frame + 1, size - 2) == frame[size - 1];
+}
+
+bool AdsRecordDecoder::decodeFrame(AdsSample &sample) {
+    if (frame[0] == ADS_RECORD_TIME_SYNC) {
+        lastTimestamp = (uint32_t)frame[1] | ((uint32_t)frame[2] << 8) | ((uint32_t)frame[3] << 16) | ((uint32_t)frame[4] << 24);
+        timeSynced = true;
+        return false;
+    }
+
+    uint8_t header = frame[1];
+    lastTimestamp += (uint16_t)(frame[2] | ((uint16_t)frame[3] << 8));
+
+    sample.device = header >> 6;
+    sample.mux = (MuxConfig)((uint16_t)((header >> 3) & 0x7) << 12);
+    sample.gain = (AdsGain)((uint16_t)(header & 0x7) << 9);
+    sample.timestampMicros = lastTimestamp;
+    sample.raw = (int16_t)(frame[4] | ((uint16_t)frame[5] << 8));
+    return true;
+}
+
+void AdsRecordDecoder::resync() {
+    byte start = 1;
+    while (start < frameLength && frameSizeOf(frame[start]) == 0) {
+        start++;
+    }
+
+    for (byte i = start; i < frameLength; i++) {
+        frame[i - start] = frame[i];
+    }
+    frameLength -= start;
+}
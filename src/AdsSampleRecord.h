@@ -0,0 +1,146 @@
+#ifndef __ADS_SAMPLE_RECORD_H__
+#define __ADS_SAMPLE_RECORD_H__
+
+#include "Ads1115Plus.h"
+
+/// The first byte of a sample frame
+#define ADS_RECORD_SAMPLE_SYNC 0xA5
+
+/// The first byte of a time frame
+#define ADS_RECORD_TIME_SYNC 0xA6
+
+/// The size in bytes of a sample frame
+#define ADS_RECORD_SAMPLE_SIZE 7
+
+/// The size in bytes of a time frame
+#define ADS_RECORD_TIME_SIZE 6
+
+/// The largest frame size, use it for the buffers given to AdsRecordEncoder::encode()
+#define ADS_RECORD_MAX_SIZE (ADS_RECORD_TIME_SIZE + ADS_RECORD_SAMPLE_SIZE)
+
+/// The default number of sample frames between time frames (limits the samples with unknown time after a lost frame)
+#define ADS_RECORD_DEFAULT_TIME_INTERVAL 256
+
+/**
+ * Encodes AdsSample into a compact binary stream (7 bytes per sample instead of ~30 printing them as text)
+ *
+ * Sample frame (7 bytes):
+ * - 0xA5
+ * - header: device (bits 7:6), mux index (bits 5:3), gain index (bits 2:0)
+ * - uint16 microseconds since the previous frame (little endian)
+ * - int16 raw value (little endian)
+ * - CRC-8 (polynomial 0x07) of the header, time and raw bytes
+ *
+ * Time frame (6 bytes), sent before the first sample, when the time since the previous frame doesn't fit 16 bits and
+ * periodically so a decoder can recover the time after a lost frame:
+ * - 0xA6
+ * - uint32 timestamp in microseconds (little endian)
+ * - CRC-8 of the timestamp bytes
+ */
+class AdsRecordEncoder {
+
+private:
+
+    /// The timestamp of the last frame encoded
+    uint32_t lastTimestamp;
+
+    /// The number of sample frames since the last time frame
+    uint16_t framesSinceTime;
+
+    /// The number of sample frames between time frames
+    uint16_t timeInterval;
+
+    /// True until the first time frame is encoded
+    bool needsTime;
+
+public:
+
+    /**
+     * Creates an encoder
+     * @param timeInterval The number of sample frames between time frames (0 to only send them when needed)
+     */
+    AdsRecordEncoder(uint16_t timeInterval = ADS_RECORD_DEFAULT_TIME_INTERVAL);
+
+    /// Makes the next encoded sample start with a time frame (use it when a new decoder connects)
+    void reset();
+
+    /**
+     * Encodes the given [sample] (preceded by a time frame when needed)
+     * @param buffer Receives the frames, must hold at least ADS_RECORD_MAX_SIZE bytes
+     * @return The number of bytes written to the buffer
+     */
+    size_t encode(const AdsSample &sample, uint8_t *buffer);
+
+    /**
+     * Encodes the given [sample] and writes it to [output] (e.g. Serial)
+     * @return The number of bytes written
+     */
+    size_t write(Print &output, const AdsSample &sample);
+
+    /// Returns the CRC-8 (polynomial 0x07, initial value 0) of the given [data]
+    static uint8_t crc8(const uint8_t *data, size_t length);
+};
+
+/**
+ * Decodes the stream written by AdsRecordEncoder, one byte at a time
+ * Frames with a wrong CRC are dropped and the decoder re-synchronizes on the next sync byte
+ * After a dropped frame the timestamps aren't reliable until the next time frame (see isTimeSynced())
+ */
+class AdsRecordDecoder {
+
+private:
+
+    /// The bytes of the frame being decoded
+    uint8_t frame[ADS_RECORD_SAMPLE_SIZE];
+
+    /// The number of bytes in [frame]
+    byte frameLength;
+
+    /// The timestamp of the last frame decoded
+    uint32_t lastTimestamp;
+
+    /// Whether [lastTimestamp] can be trusted
+    bool timeSynced;
+
+    /// The number of frames dropped (wrong CRC)
+    uint32_t droppedFrames;
+
+    /// Returns the expected size of the frame starting with the given [sync] byte (0 if it isn't a sync byte)
+    static byte frameSizeOf(uint8_t sync);
+
+    /// Returns whether the CRC of the frame of the given [size] in [frame] is valid
+    bool crc8Matches(byte size);
+
+    /**
+     * Decodes the complete frame in [frame]
+     * @return true if the frame was a valid sample frame ([sample] is set)
+     */
+    bool decodeFrame(AdsSample &sample);
+
+    /// Drops the first byte of [frame] and keeps the rest from the next sync byte
+    void resync();
+
+public:
+
+    /// Creates a decoder waiting for the first frame
+    AdsRecordDecoder();
+
+    /// Drops any partial frame and waits for the next time frame
+    void reset();
+
+    /**
+     * Feeds the next byte of the stream
+     * @param value The byte received
+     * @param sample Set to the decoded sample when true is returned
+     * @return true when a sample frame has been completed
+     */
+    bool feed(uint8_t value, AdsSample &sample);
+
+    /// Returns whether the timestamps of the decoded samples can be trusted
+    bool isTimeSynced();
+
+    /// Returns the number of frames dropped because of a wrong CRC
+    uint32_t getDroppedFrames();
+};
+
+#endif
@@ -0,0 +1,278 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsScanner.h"
+
+
+double AdsJitterStats::meanMicros() const {
+    return count == 0 ? 0 : (double)sumMicros / count;
+}
+
+double AdsJitterStats::stddevMicros() const {
+    if (count == 0) {
+        return 0;
+    }
+    double mean = meanMicros();
+    double variance = (double)sumSquaredMicros / count - mean * mean;
+    return variance > 0 ? sqrt(variance) : 0;
+}
+
+AdsScanner::AdsScanner(Ads1115Plus &ads) : ads(ads) {
+    slotCount = 0;
+    currentSlot = 0;
+    periodMicros = 0;
+    nextStartMicros = 0;
+    conversionStartMicros = 0;
+    converting = false;
+    settling = false;
+    hasLastConfig = false;
+    lastMux = MuxConfig::channel0;
+    lastGain = AdsGain::twoThirds;
+    lastSpeed = AdsSampleSpeed::sps8;
+    settlingConversions = 0;
+    usefulConversions = 0;
+    running = false;
+    sampleCallback = nullptr;
+    callbackContext = nullptr;
+    resetJitterStats();
+}
+
+bool AdsScanner::addSlot(MuxConfig mux, AdsGain gain, AdsSampleSpeed speed, bool discardAfterSwitch) {
+    if (slotCount >= ADS_MAX_SCAN_SLOTS) {
+        return false;
+    }
+    slots[slotCount].mux = mux;
+    slots[slotCount].gain = gain;
+    slots[slotCount].speed = speed;
+    slots[slotCount].discardAfterSwitch = discardAfterSwitch;
+    slotCount++;
+    return true;
+}
+
+void AdsScanner::clearSlots() {
+    stop();
+    slotCount = 0;
+}
+
+byte AdsScanner::getSlotCount() {
+    return slotCount;
+}
+
+void AdsScanner::groupSlots() {
+    stop();
+
+    // Insertion sort (stable) by mux, gain and speed
+    for (byte i = 1; i < slotCount; i++) {
+        AdsScanSlot current = slots[i];
+        uint16_t key = (uint16_t)current.mux | (uint16_t)current.gain | (uint16_t)current.speed;
+
+        byte j = i;
+        while (j > 0 && ((uint16_t)slots[j - 1].mux | (uint16_t)slots[j - 1].gain | (uint16_t)slots[j - 1].speed) > key) {
+            slots[j] = slots[j - 1];
+            j--;
+        }
+        slots[j] = current;
+    }
+}
+
+AdsScanSlot &AdsScanner::slot(byte index) {
+    return slots[index % ADS_MAX_SCAN_SLOTS];
+}
+
+Ads1115Plus &AdsScanner::device() {
+    return ads;
+}
+
+void AdsScanner::setSampleCallback(AdsSampleCallback callback, void *context) {
+    sampleCallback = callback;
+    callbackContext = context;
+}
+
+bool AdsScanner::start(unsigned long periodMicros, unsigned long phaseMicros) {
+    if (slotCount == 0) {
+        return false;
+    }
+    this->periodMicros = periodMicros;
+    currentSlot = 0;
+    converting = false;
+    settling = false;
+    hasLastConfig = false;
+    settlingConversions = 0;
+    usefulConversions = 0;
+    running = true;
+    nextStartMicros = micros() + phaseMicros;
+    resetJitterStats();
+    return true;
+}
+
+void AdsScanner::stop() {
+    running = false;
+    converting = false;
+}
+
+bool AdsScanner::isRunning() {
+    return running;
+}
+
+bool AdsScanner::poll() {
+    if (!running) {
+        return false;
+    }
+
+    uint32_t now = micros();
+    if (converting) {
+        if (now - conversionStartMicros < Ads1115Plus::conversionTimeMicros(slots[currentSlot].speed)) {
+            return false;
+        }
+        if (settling) {
+            // The input had the settling conversion to settle, start the one that is kept
+            settling = false;
+            settlingConversions++;
+            conversionStartMicros = now;
+            ads.startSingleShotOnMux(slots[currentSlot].mux);
+            return false;
+        }
+        finishConversion();
+        return true;
+    }
+
+    // Signed difference, so the comparison survives the micros() overflow
+    if ((int32_t)(now - nextStartMicros) < 0) {
+        return false;
+    }
+    startConversion(now);
+    return false;
+}
+
+uint32_t AdsScanner::microsUntilNextEvent() {
+    if (!running) {
+        return 0xFFFFFFFF;
+    }
+
+    uint32_t now = micros();
+    if (converting) {
+        uint32_t elapsed = now - conversionStartMicros;
+        uint32_t conversionTime = Ads1115Plus::conversionTimeMicros(slots[currentSlot].speed);
+        return elapsed >= conversionTime ? 0 : conversionTime - elapsed;
+    }
+
+    int32_t untilStart = (int32_t)(nextStartMicros - now);
+    return untilStart > 0 ? untilStart : 0;
+}
+
+unsigned long AdsScanner::minimumPeriodMicros() {
+    unsigned long longest = 0;
+    for (byte i = 0; i < slotCount; i++) {
+        unsigned long conversionTime = Ads1115Plus::conversionTimeMicros(slots[i].speed);
+
+        // The previous slot (wrapping around the scan list) determines whether the config changes
+        byte previous = i == 0 ? slotCount - 1 : i - 1;
+        if (slots[i].discardAfterSwitch && slotCount > 1 && !sharesConfig(i, previous)) {
+            conversionTime *= 2;
+        }
+        if (conversionTime > longest) {
+            longest = conversionTime;
+        }
+    }
+    return longest;
+}
+
+uint32_t AdsScanner::getSettlingConversions() {
+    return settlingConversions;
+}
+
+uint32_t AdsScanner::getUsefulConversions() {
+    return usefulConversions;
+}
+
+AdsJitterStats AdsScanner::getJitterStats() {
+    return jitterStats;
+}
+
+void AdsScanner::resetJitterStats() {
+    jitterStats.count = 0;
+    jitterStats.minMicros = 0xFFFFFFFF;
+    jitterStats.maxMicros = 0;
+    jitterStats.sumMicros = 0;
+    jitterStats.sumSquaredMicros = 0;
+    jitterStats.overruns = 0;
+}
+
+// MARK: Private methods
+
+void AdsScanner::recordJitter(uint32_t jitter) {
+    jitterStats.count++;
+    if (jitter < jitterStats.minMicros) {
+        jitterStats.minMicros = jitter;
+    }
+    if (jitter > jitterStats.maxMicros) {
+        jitterStats.maxMicros = jitter;
+    }
+    jitterStats.sumMicros += jitter;
+    jitterStats.sumSquaredMicros += (uint64_t)jitter * jitter;
+}
+
+void AdsScanner::startConversion(uint32_t now) {
+    configureAndStart();
+
+    conversionStartMicros = now;
+    converting = true;
+    recordJitter(now - nextStartMicros);
+
+    // Keep the grid: the next start is planned from the scheduled time, not from now
+    nextStartMicros += periodMicros;
+    if ((int32_t)(now - nextStartMicros) >= 0 && periodMicros > 0) {
+        uint32_t missed = (now - nextStartMicros) / periodMicros + 1;
+        nextStartMicros += missed * periodMicros;
+        jitterStats.overruns += missed;
+    }
+}
+
+void AdsScanner::finishConversion() {
+    const AdsScanSlot &current = slots[currentSlot];
+
+    AdsSample sample;
+    sample.raw = ads.getLastConversionResults();
+    sample.timestampMicros = conversionStartMicros;
+    sample.device = (byte)ads.getAddress() - (byte)AdsAddress::gnd;
+    sample.mux = current.mux;
+    sample.gain = current.gain;
+
+    converting = false;
+    usefulConversions++;
+    currentSlot = (currentSlot + 1) % slotCount;
+
+    if (sampleCallback != nullptr) {
+        sampleCallback(sample, callbackContext);
+    }
+}
+
+void AdsScanner::configureAndStart() {
+    const AdsScanSlot &current = slots[currentSlot];
+    bool configChanged = !hasLastConfig || current.mux != lastMux || current.gain != lastGain || current.speed != lastSpeed;
+
+    ads.setGain(current.gain, false);
+    ads.setSampleSpeed(current.speed, false);
+    ads.startSingleShotOnMux(current.mux);
+
+    settling = configChanged && current.discardAfterSwitch;
+    hasLastConfig = true;
+    lastMux = current.mux;
+    lastGain = current.gain;
+    lastSpeed = current.speed;
+}
+
+bool AdsScanner::sharesConfig(byte index, byte otherIndex) {
+    return slots[index].mux == slots[otherIndex].mux && slots[index].gain == slots[otherIndex].gain && slots[index].speed == slots[otherIndex].speed;
+}
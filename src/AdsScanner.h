@@ -0,0 +1,233 @@
+#ifndef __ADS_SCANNER_H__
+#define __ADS_SCANNER_H__
+
+#include "Ads1115Plus.h"
+
+/// The maximum number of slots in the scan list of an AdsScanner
+#define ADS_MAX_SCAN_SLOTS 8
+
+/** An entry of the scan list: what is read and how */
+struct AdsScanSlot {
+
+    /// The channel (single or differential) read
+    MuxConfig mux;
+
+    /// The gain used for the conversion
+    AdsGain gain;
+
+    /// The sample speed used for the conversion
+    AdsSampleSpeed speed;
+
+    /**
+     * When true, a conversion is performed and discarded before reading this slot if the mux, gain or speed changed
+     * Use it for inputs with a high source impedance, where the first conversion after a switch can be off
+     */
+    bool discardAfterSwitch;
+};
+
+/**
+ * The timing quality of the conversions started by an AdsScanner
+ * The jitter is the time between the scheduled start of a conversion and the time it was actually started
+ */
+struct AdsJitterStats {
+
+    /// The number of conversions started
+    uint32_t count;
+
+    /// The smallest jitter in microseconds
+    uint32_t minMicros;
+
+    /// The largest jitter in microseconds
+    uint32_t maxMicros;
+
+    /// The sum of the jitters (used for the mean)
+    uint64_t sumMicros;
+
+    /// The sum of the squared jitters (used for the standard deviation)
+    uint64_t sumSquaredMicros;
+
+    /// The number of scheduled conversions skipped because the previous one was still running (or poll() was called too late)
+    uint32_t overruns;
+
+    /// Returns the mean jitter in microseconds
+    double meanMicros() const;
+
+    /// Returns the standard deviation of the jitter in microseconds
+    double stddevMicros() const;
+};
+
+/// Called with each sample produced by an AdsScanner
+typedef void (*AdsSampleCallback)(const AdsSample &sample, void *context);
+
+/**
+ * Reads a list of slots (mux, gain and sample speed) from a single ADS1115 at evenly spaced times
+ *
+ * Conversions are started on a fixed grid of [periodMicros] planned against micros(), one slot per grid point:
+ * - poll() never blocks, call it as often as possible from loop()
+ * - A late conversion is started right away and the grid is kept, so the timing doesn't drift
+ * - When a grid point is missed entirely (conversion still running) it is skipped and counted as an overrun
+ * - The samples are timestamped with the micros() when the conversion was started
+ * - Slots with discardAfterSwitch perform an extra conversion when the config changes, within the same grid point
+ *
+ * Note the ADS1115 converts at most 860 samples per second, for a higher aggregate rate use one scanner per device
+ * with the same period and different phases (e.g. 2 devices, period 2000us, phases 0 and 1000us for 1kHz)
+ */
+class AdsScanner {
+
+private:
+
+    /// The device read
+    Ads1115Plus &ads;
+
+    /// The scan list
+    AdsScanSlot slots[ADS_MAX_SCAN_SLOTS];
+
+    /// The number of slots in the scan list
+    byte slotCount;
+
+    /// The slot of the conversion being performed (or of the next one)
+    byte currentSlot;
+
+    /// The time between the start of two conversions
+    unsigned long periodMicros;
+
+    /// The scheduled start of the next conversion
+    uint32_t nextStartMicros;
+
+    /// The time the conversion being performed was started
+    uint32_t conversionStartMicros;
+
+    /// True while a conversion is being performed
+    bool converting;
+
+    /// True while the conversion being performed will be discarded (settling after a switch)
+    bool settling;
+
+    /// Whether [lastMux], [lastGain] and [lastSpeed] hold the config of the previous conversion
+    bool hasLastConfig;
+
+    /// The mux of the previous conversion
+    MuxConfig lastMux;
+
+    /// The gain of the previous conversion
+    AdsGain lastGain;
+
+    /// The sample speed of the previous conversion
+    AdsSampleSpeed lastSpeed;
+
+    /// The number of conversions discarded to let the input settle
+    uint32_t settlingConversions;
+
+    /// The number of conversions handed to the callback
+    uint32_t usefulConversions;
+
+    /// True between start() and stop()
+    bool running;
+
+    /// Called with each sample
+    AdsSampleCallback sampleCallback;
+
+    /// Given to [sampleCallback]
+    void *callbackContext;
+
+    /// The timing quality since the last resetJitterStats()
+    AdsJitterStats jitterStats;
+
+    /// Adds the [jitter] of a conversion start to [jitterStats]
+    void recordJitter(uint32_t jitter);
+
+    /// Starts the conversion of [currentSlot]
+    void startConversion(uint32_t now);
+
+    /// Starts the conversion of [currentSlot] on the device (a settling one when needed)
+    void configureAndStart();
+
+    /// Returns true if the slot at [index] uses the same mux, gain and speed as the slot at [otherIndex]
+    bool sharesConfig(byte index, byte otherIndex);
+
+    /// Reads the conversion of [currentSlot] and hands it to the callback
+    void finishConversion();
+
+public:
+
+    /// Creates a scanner for the given device, with an empty scan list
+    AdsScanner(Ads1115Plus &ads);
+
+    /**
+     * Adds a slot to the end of the scan list
+     * @return false if the scan list is full (ADS_MAX_SCAN_SLOTS)
+     */
+    bool addSlot(MuxConfig mux, AdsGain gain = AdsGain::twoThirds, AdsSampleSpeed speed = AdsSampleSpeed::sps860, bool discardAfterSwitch = false);
+
+    /// Removes all the slots (stops the scanner)
+    void clearSlots();
+
+    /// Returns the number of slots in the scan list
+    byte getSlotCount();
+
+    /**
+     * Reorders the scan list so slots sharing mux, gain and speed are next to each other (stops the scanner)
+     * This keeps the config changes (and the settling conversions of the slots with discardAfterSwitch) to a minimum
+     * The order of slots sharing a config is kept
+     */
+    void groupSlots();
+
+    /// Returns the slot at the given [index] of the scan list (can be modified while stopped)
+    AdsScanSlot &slot(byte index);
+
+    /// Returns the device read by this scanner
+    Ads1115Plus &device();
+
+    /**
+     * Sets the function called with each sample (from poll())
+     * @param context Given back to the [callback]
+     */
+    void setSampleCallback(AdsSampleCallback callback, void *context = nullptr);
+
+    /**
+     * Starts scanning
+     * @param periodMicros The time between the start of two conversions (the scan list is read every periodMicros * slot count)
+     * @param phaseMicros Delays the first conversion, used to interleave scanners of different devices
+     * @return false if the scan list is empty
+     */
+    bool start(unsigned long periodMicros, unsigned long phaseMicros = 0);
+
+    /// Stops scanning, a conversion being performed is discarded
+    void stop();
+
+    /// Returns true between start() and stop()
+    bool isRunning();
+
+    /**
+     * Reads the finished conversion and starts the next one when it is due
+     * @return true if a sample was produced (and handed to the callback)
+     */
+    bool poll();
+
+    /**
+     * Returns the time in microseconds until poll() has something to do (0 if it is due now)
+     * Use it to sleep between polls, returns 0xFFFFFFFF when stopped
+     */
+    uint32_t microsUntilNextEvent();
+
+    /**
+     * Returns the shortest period that can be kept without overruns
+     * (the longest conversion time of the scan list, including the settling conversions)
+     * Note the time needed for the i2c transactions and the rest of loop() must be added
+     */
+    unsigned long minimumPeriodMicros();
+
+    /// Returns the number of conversions discarded to let the inputs settle since start()
+    uint32_t getSettlingConversions();
+
+    /// Returns the number of conversions read and handed to the callback since start()
+    uint32_t getUsefulConversions();
+
+    /// Returns the timing quality since start() or the last resetJitterStats()
+    AdsJitterStats getJitterStats();
+
+    /// Clears the timing quality statistics
+    void resetJitterStats();
+};
+
+#endif
@@ -0,0 +1,388 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsSimulator.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+/// Config register bit 15: start a single shot conversion (write) / not converting (read)
+#define SIM_OS_BIT 0x8000
+
+/// Config register bit 8: single shot mode
+#define SIM_MODE_BIT 0x0100
+
+/// The most conversions processed at once in continuous mode (enough for the comparator queue)
+#define SIM_MAX_CATCH_UP 8
+
+
+AdsSimulator::AdsSimulator() {
+    for (byte i = 0; i < 4; i++) {
+        resetDevice(devices[i]);
+        devices[i].present = false;
+        devices[i].alertPulses = 0;
+        devices[i].activeMicros = 0;
+        for (byte mux = 0; mux < ADS_MUX_COUNT; mux++) {
+            inputs[i][mux] = 0;
+        }
+    }
+    signalSource = nullptr;
+    busClock = 400000;
+    transferCount = 0;
+    busBits = 0;
+    energyStartMicros = micros();
+}
+
+AdsSimulator::~AdsSimulator() {
+    detach();
+}
+
+void AdsSimulator::attach() {
+    AdsLinuxI2c::setTransferHook(transferHook, this);
+}
+
+void AdsSimulator::detach() {
+    AdsLinuxI2c::setTransferHook(nullptr);
+}
+
+void AdsSimulator::addDevice(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    Device &device = devices[indexOf((byte)address)];
+    resetDevice(device);
+    device.present = true;
+    device.activeMicros = 0;
+}
+
+void AdsSimulator::removeDevice(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    devices[indexOf((byte)address)].present = false;
+}
+
+void AdsSimulator::setInputMicrovolts(AdsAddress address, MuxConfig mux, int32_t microvolts) {
+    std::lock_guard<std::mutex> guard(lock);
+    inputs[indexOf((byte)address)][Ads1115Plus::muxIndex(mux)] = microvolts;
+}
+
+void AdsSimulator::setSignalSource(AdsSignalSource *source) {
+    std::lock_guard<std::mutex> guard(lock);
+    signalSource = source;
+}
+
+uint16_t AdsSimulator::getRegister(AdsAddress address, byte reg) {
+    std::lock_guard<std::mutex> guard(lock);
+    byte index = indexOf((byte)address);
+    update(index, micros());
+
+    // Read through the pointer without changing it
+    Device &device = devices[index];
+    uint8_t pointer = device.pointer;
+    device.pointer = reg & 0x3;
+    uint16_t value = device.pointer == 0 ? (uint16_t)device.conversion : readRegister(index);
+    device.pointer = pointer;
+    return value;
+}
+
+bool AdsSimulator::isAlertAsserted(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    byte index = indexOf((byte)address);
+    update(index, micros());
+    return devices[index].alertAsserted;
+}
+
+uint32_t AdsSimulator::getAlertPulses(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    byte index = indexOf((byte)address);
+    update(index, micros());
+    return devices[index].alertPulses;
+}
+
+void AdsSimulator::setBusClock(uint32_t hz) {
+    std::lock_guard<std::mutex> guard(lock);
+    busClock = hz > 0 ? hz : 1;
+}
+
+uint32_t AdsSimulator::getTransferCount() {
+    std::lock_guard<std::mutex> guard(lock);
+    return transferCount;
+}
+
+unsigned long AdsSimulator::getBusMicros() {
+    std::lock_guard<std::mutex> guard(lock);
+    return (unsigned long)(busBits * 1000000ULL / busClock);
+}
+
+void AdsSimulator::resetBusStats() {
+    std::lock_guard<std::mutex> guard(lock);
+    transferCount = 0;
+    busBits = 0;
+}
+
+unsigned long AdsSimulator::getActiveMicros(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    byte index = indexOf((byte)address);
+    update(index, micros());
+    return (unsigned long)devices[index].activeMicros;
+}
+
+uint64_t AdsSimulator::getChargeNanocoulombs(AdsAddress address) {
+    std::lock_guard<std::mutex> guard(lock);
+    byte index = indexOf((byte)address);
+    uint32_t now = micros();
+    update(index, now);
+
+    uint64_t active = devices[index].activeMicros;
+    uint64_t elapsed = now - energyStartMicros;
+    uint64_t idle = elapsed > active ? elapsed - active : 0;
+    return (active * ADS_ACTIVE_CURRENT_NANOAMPS + idle * ADS_POWER_DOWN_CURRENT_NANOAMPS) / 1000000;
+}
+
+void AdsSimulator::resetEnergyStats() {
+    std::lock_guard<std::mutex> guard(lock);
+    uint32_t now = micros();
+    for (byte index = 0; index < 4; index++) {
+        update(index, now);
+        devices[index].activeMicros = 0;
+    }
+    energyStartMicros = now;
+}
+
+int AdsSimulator::transfer(struct i2c_rdwr_ioctl_data *transfer) {
+    std::lock_guard<std::mutex> guard(lock);
+    return performTransfer(transfer);
+}
+
+// MARK: Private methods
+
+int AdsSimulator::transferHook(struct i2c_rdwr_ioctl_data *transfer, void *simulator) {
+    return ((AdsSimulator *)simulator)->transfer(transfer);
+}
+
+int AdsSimulator::indexOf(byte address) {
+    if (address < (byte)AdsAddress::gnd || address > (byte)AdsAddress::scl) {
+        return -1;
+    }
+    return address - (byte)AdsAddress::gnd;
+}
+
+void AdsSimulator::resetDevice(Device &device) {
+    device.pointer = 0;
+    device.config = ADS_CONFIG_RESET_VALUE & ~SIM_OS_BIT;
+    device.lowThreshold = 0x8000;
+    device.highThreshold = 0x7FFF;
+    device.conversion = 0;
+    device.converting = false;
+    device.conversionStart = 0;
+    device.completedConversions = 0;
+    device.alertAsserted = false;
+    device.queueCount = 0;
+}
+
+uint32_t AdsSimulator::conversionPeriodMicros(uint16_t config) {
+    return Ads1115Plus::samplePeriodMicros((AdsSampleSpeed)(config & 0x00E0));
+}
+
+int AdsSimulator::performTransfer(struct i2c_rdwr_ioctl_data *transfer) {
+    uint32_t now = micros();
+    transferCount++;
+
+    for (uint32_t i = 0; i < transfer->nmsgs; i++) {
+        struct i2c_msg &message = transfer->msgs[i];
+
+        // Start (or repeated start) + address byte + data bytes, each byte followed by an ack bit
+        busBits += 1 + 9 + 9 * (uint64_t)message.len;
+
+        // General call reset
+        if (message.addr == 0x00) {
+            if (!(message.flags & I2C_M_RD) && message.len >= 1 && message.buf[0] == 0x06) {
+                for (byte index = 0; index < 4; index++) {
+                    uint32_t alertPulses = devices[index].alertPulses;
+                    bool present = devices[index].present;
+                    resetDevice(devices[index]);
+                    devices[index].present = present;
+                    devices[index].alertPulses = alertPulses;
+                }
+            }
+            continue;
+        }
+
+        int index = indexOf(message.addr);
+        if (index < 0 || !devices[index].present) {
+            busBits += 1; // stop
+            return -1; // Not acknowledged (ENXIO from the adapter)
+        }
+        update(index, now);
+        Device &device = devices[index];
+
+        if (message.flags & I2C_M_RD) {
+            uint16_t value = readRegister(index);
+            for (uint16_t position = 0; position < message.len; position++) {
+                message.buf[position] = position % 2 == 0 ? value >> 8 : value & 0xFF;
+            }
+        } else if (message.len >= 1) {
+            device.pointer = message.buf[0] & 0x3;
+            if (message.len >= 3) {
+                writeRegister(index, ((uint16_t)message.buf[1] << 8) | message.buf[2], now);
+            }
+        }
+    }
+
+    busBits += 1; // stop
+    return 0;
+}
+
+void AdsSimulator::update(byte index, uint32_t now) {
+    Device &device = devices[index];
+    uint32_t period = conversionPeriodMicros(device.config);
+
+    if (device.config & SIM_MODE_BIT) {
+        if (device.converting && now - device.conversionStart >= period) {
+            device.converting = false;
+            device.activeMicros += period;
+            completeConversion(index, device.conversionStart + period);
+        }
+        return;
+    }
+
+    // Continuous mode: process the conversions finished since the last update (the last few are enough)
+    uint32_t finished = (now - device.conversionStart) / period;
+    device.activeMicros += (uint64_t)(finished - device.completedConversions) * period;
+    if (finished - device.completedConversions > SIM_MAX_CATCH_UP) {
+        device.completedConversions = finished - SIM_MAX_CATCH_UP;
+    }
+    while (device.completedConversions < finished) {
+        device.completedConversions++;
+        completeConversion(index, device.conversionStart + device.completedConversions * period);
+    }
+}
+
+void AdsSimulator::completeConversion(byte index, uint32_t time) {
+    Device &device = devices[index];
+    MuxConfig mux = (MuxConfig)(device.config & 0x7000);
+    AdsGain gain = (AdsGain)(device.config & 0x0E00);
+
+    // The input is sampled at the middle of the conversion
+    uint32_t middle = time - conversionPeriodMicros(device.config) / 2;
+    int32_t microvolts = signalSource != nullptr ? signalSource->inputMicrovolts(index, mux, middle) : inputs[index][Ads1115Plus::muxIndex(mux)];
+
+    // raw = microvolts / LSB, rounded to the nearest and clamped to the full scale
+    byte shift = Ads1115Plus::microvoltsShift(gain);
+    int64_t scaled = (int64_t)microvolts * ((int64_t)1 << shift);
+    int64_t multiplier = Ads1115Plus::microvoltsMultiplier(gain);
+    int64_t raw = (scaled >= 0 ? scaled + multiplier / 2 : scaled - multiplier / 2) / multiplier;
+    device.conversion = raw > 32767 ? 32767 : (raw < -32768 ? -32768 : (int16_t)raw);
+
+    // Comparator
+    byte queue = device.config & 0x3;
+    if (queue == 0x3) {
+        device.alertAsserted = false;
+        device.queueCount = 0;
+        return;
+    }
+
+    int16_t high = (int16_t)device.highThreshold;
+    int16_t low = (int16_t)device.lowThreshold;
+    if ((device.highThreshold & 0x8000) && !(device.lowThreshold & 0x8000)) {
+        device.alertPulses++; // Conversion ready pulse
+        return;
+    }
+
+    bool window = device.config & 0x0010;
+    bool latching = device.config & 0x0004;
+    bool beyond = window ? (device.conversion > high || device.conversion < low) : device.conversion > high;
+    byte required = queue == 0 ? 1 : (queue == 1 ? 2 : 4);
+
+    if (beyond) {
+        if (device.queueCount < 4) {
+            device.queueCount++;
+        }
+        if (device.queueCount >= required && !device.alertAsserted) {
+            device.alertAsserted = true;
+            device.alertPulses++;
+        }
+        return;
+    }
+
+    device.queueCount = 0;
+    if (!latching && device.alertAsserted) {
+        bool cleared = window ? true : device.conversion < low;
+        if (cleared) {
+            device.alertAsserted = false;
+        }
+    }
+}
+
+void AdsSimulator::writeRegister(byte index, uint16_t value, uint32_t now) {
+    Device &device = devices[index];
+
+    switch (device.pointer) {
+
+    case 0x1: {
+        bool wasContinuous = !(device.config & SIM_MODE_BIT);
+        uint16_t previousConfig = device.config;
+        device.config = value & ~SIM_OS_BIT;
+
+        if (device.config & SIM_MODE_BIT) {
+            // Single shot: a conversion starts when OS is written while powered down
+            if ((value & SIM_OS_BIT) && !device.converting) {
+                device.converting = true;
+                device.conversionStart = now;
+            }
+        } else if (!wasContinuous || previousConfig != device.config) {
+            // Continuous: the conversions restart with the new config
+            device.converting = false;
+            device.conversionStart = now;
+            device.completedConversions = 0;
+        }
+        break;
+    }
+
+    case 0x2:
+        device.lowThreshold = value;
+        break;
+
+    case 0x3:
+        device.highThreshold = value;
+        break;
+
+    default:
+        break; // The conversion register is read only
+    }
+}
+
+uint16_t AdsSimulator::readRegister(byte index) {
+    Device &device = devices[index];
+
+    switch (device.pointer) {
+
+    case 0x0:
+        // Reading the conversion clears a latched comparator
+        if (device.config & 0x0004) {
+            device.alertAsserted = false;
+            device.queueCount = 0;
+        }
+        return (uint16_t)device.conversion;
+
+    case 0x1: {
+        bool busy = device.converting || !(device.config & SIM_MODE_BIT);
+        return device.config | (busy ? 0 : SIM_OS_BIT);
+    }
+
+    case 0x2:
+        return device.lowThreshold;
+
+    default:
+        return device.highThreshold;
+    }
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef __ADS_SIMULATOR_H__
+#define __ADS_SIMULATOR_H__
+
+#include "Ads1115Plus.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+#include <mutex>
+
+/** Provides the voltages seen by the simulated devices (see AdsSimulator::setSignalSource) */
+class AdsSignalSource {
+
+public:
+
+    virtual ~AdsSignalSource() {}
+
+    /**
+     * Returns the voltage on the given [mux] of the given [device] at the given simulated time
+     * @param device The index of the device on the bus (address - AdsAddress::gnd)
+     * @param timeMicros The micros() at the middle of the conversion
+     * @return The input voltage in microvolts
+     */
+    virtual int32_t inputMicrovolts(byte device, MuxConfig mux, uint32_t timeMicros) = 0;
+};
+
+/**
+ * A register model of up to four ADS1115 on a simulated i2c bus, so the driver can run on Linux without hardware
+ *
+ * attach() routes the AdsLinuxI2c transfers to the simulator, the driver still builds the same I2C_RDWR messages.
+ * The model covers:
+ * - The four registers, the address pointer, the power-up / general call reset values
+ * - Single shot and continuous conversions, taking the nominal time of the configured data rate
+ * - The comparator (traditional / window, latching, queue, disabled) and the conversion ready mode of ALERT/RDY
+ * - Devices being added or removed (not acknowledged) at any time
+ * - The number of transfers and the time they take on the bus at a given clock
+ */
+class AdsSimulator {
+
+private:
+
+    /** The state of a simulated device */
+    struct Device {
+
+        /// Whether the device acknowledges its address
+        bool present;
+
+        /// The address pointer register
+        uint8_t pointer;
+
+        /// The config register (bit 15 is computed when read)
+        uint16_t config;
+
+        /// The low threshold register
+        uint16_t lowThreshold;
+
+        /// The high threshold register
+        uint16_t highThreshold;
+
+        /// The conversion register
+        int16_t conversion;
+
+        /// True while a single shot conversion is being performed
+        bool converting;
+
+        /// The start of the single shot conversion, or of the continuous conversions
+        uint32_t conversionStart;
+
+        /// The number of conversions done since [conversionStart] in continuous mode
+        uint32_t completedConversions;
+
+        /// Whether the ALERT/RDY pin is asserted by the comparator
+        bool alertAsserted;
+
+        /// The number of consecutive conversions beyond the thresholds
+        byte queueCount;
+
+        /// The number of times ALERT/RDY was asserted (or pulsed in conversion ready mode)
+        uint32_t alertPulses;
+
+        /// The time spent converting since resetEnergyStats()
+        uint64_t activeMicros;
+    };
+
+    /// The devices indexed by (address - AdsAddress::gnd)
+    Device devices[4];
+
+    /// The constant input of each mux of each device in microvolts (used when there is no signal source)
+    int32_t inputs[4][ADS_MUX_COUNT];
+
+    /// Provides the inputs when set
+    AdsSignalSource *signalSource;
+
+    /// The simulated bus clock in Hz
+    uint32_t busClock;
+
+    /// The number of transfers since resetBusStats()
+    uint32_t transferCount;
+
+    /// The number of bits clocked on the bus since resetBusStats()
+    uint64_t busBits;
+
+    /// The micros() of the last resetEnergyStats()
+    uint32_t energyStartMicros;
+
+    /// Serializes the transfers and the public methods
+    std::mutex lock;
+
+    /// The AdsLinuxI2c transfer hook
+    static int transferHook(struct i2c_rdwr_ioctl_data *transfer, void *simulator);
+
+    /// Returns the index of the given [address] (0 to 3), or -1 if it isn't an ADS1115 address
+    static int indexOf(byte address);
+
+    /// Sets the device registers to their reset values
+    static void resetDevice(Device &device);
+
+    /// Returns the nominal conversion time of the data rate in the given [config]
+    static uint32_t conversionPeriodMicros(uint16_t config);
+
+    /// Completes the conversions that have finished by [now]
+    void update(byte index, uint32_t now);
+
+    /// Sets the conversion register of the device at [index] for a conversion finishing at [time] and runs the comparator
+    void completeConversion(byte index, uint32_t time);
+
+    /// Writes the [value] to the register pointed by the device at [index]
+    void writeRegister(byte index, uint16_t value, uint32_t now);
+
+    /// Returns the value of the register pointed by the device at [index]
+    uint16_t readRegister(byte index);
+
+    /// Performs the given [transfer] (caller holds [lock])
+    int performTransfer(struct i2c_rdwr_ioctl_data *transfer);
+
+public:
+
+    /// Creates a simulator with no devices, not attached
+    AdsSimulator();
+
+    /// Detaches the simulator
+    ~AdsSimulator();
+
+    /// Routes the AdsLinuxI2c transfers to this simulator
+    void attach();
+
+    /// Routes the AdsLinuxI2c transfers back to the bus
+    void detach();
+
+    /// Adds a device (at its reset values) on the given [address]
+    void addDevice(AdsAddress address);
+
+    /// Removes the device on the given [address], it stops acknowledging
+    void removeDevice(AdsAddress address);
+
+    /// Sets the constant voltage (in microvolts) seen on [mux] by the device on [address]
+    void setInputMicrovolts(AdsAddress address, MuxConfig mux, int32_t microvolts);
+
+    /// Provides the inputs from the given [source] instead of the constant inputs (nullptr to go back to them)
+    void setSignalSource(AdsSignalSource *source);
+
+    /// Returns the value of the register [reg] (0 conversion, 1 config, 2 low threshold, 3 high threshold) of the device on [address]
+    uint16_t getRegister(AdsAddress address, byte reg);
+
+    /// Returns whether the comparator asserts the ALERT/RDY pin of the device on [address]
+    bool isAlertAsserted(AdsAddress address);
+
+    /// Returns the number of times the ALERT/RDY pin of the device on [address] was asserted (or pulsed in conversion ready mode)
+    uint32_t getAlertPulses(AdsAddress address);
+
+    /// Sets the bus clock used to compute getBusMicros() (400kHz by default)
+    void setBusClock(uint32_t hz);
+
+    /// Returns the number of transfers (ioctl calls) since resetBusStats()
+    uint32_t getTransferCount();
+
+    /// Returns the time the transfers since resetBusStats() take on the bus
+    unsigned long getBusMicros();
+
+    /// Clears the transfer count and bus time
+    void resetBusStats();
+
+    /// Returns the time the device on [address] spent converting since resetEnergyStats()
+    unsigned long getActiveMicros(AdsAddress address);
+
+    /**
+     * Returns the charge drawn by the device on [address] since resetEnergyStats() in nanocoulombs
+     * (ADS_ACTIVE_CURRENT_NANOAMPS while converting, ADS_POWER_DOWN_CURRENT_NANOAMPS otherwise)
+     */
+    uint64_t getChargeNanocoulombs(AdsAddress address);
+
+    /// Clears the converting time of every device
+    void resetEnergyStats();
+
+    /// Performs the given [transfer], same result as ioctl(I2C_RDWR): 0 on success, -1 if a message isn't acknowledged
+    int transfer(struct i2c_rdwr_ioctl_data *transfer);
+};
+
+#endif
+
+#endif
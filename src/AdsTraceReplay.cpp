@@ -0,0 +1,231 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsTraceReplay.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+#include "AdsSampleRecord.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+AdsTraceReplay::AdsTraceReplay() {
+    speed = 1;
+    looping = false;
+    interpolating = false;
+    clear();
+}
+
+void AdsTraceReplay::clear() {
+    for (byte i = 0; i < 4 * ADS_MUX_COUNT; i++) {
+        channels[i].points.clear();
+        channels[i].cursor = 0;
+    }
+    firstTimestamp = 0;
+    durationMicros = 0;
+    sampleCount = 0;
+    sorted = true;
+    started = false;
+    lastInputMicros = 0;
+    elapsedMicros = 0;
+    lastTraceMicros = 0;
+}
+
+void AdsTraceReplay::addSample(const AdsSample &sample, AdsGain recordedGain) {
+    if (sample.device >= 4) {
+        return;
+    }
+    if (sampleCount == 0 || (int32_t)(sample.timestampMicros - firstTimestamp) < 0) {
+        // An earlier sample moves the time origin, the stored times are rebased on it
+        for (byte i = 0; i < 4 * ADS_MUX_COUNT; i++) {
+            for (Point &point : channels[i].points) {
+                point.timeMicros += firstTimestamp - sample.timestampMicros;
+            }
+        }
+        firstTimestamp = sample.timestampMicros;
+    }
+
+    // The ideal conversion, so the simulator returns the recorded raw value with the recorded gain
+    byte shift = Ads1115Plus::microvoltsShift(recordedGain);
+    Point point;
+    point.timeMicros = sample.timestampMicros - firstTimestamp;
+    point.microvolts = ((int32_t)sample.raw * Ads1115Plus::microvoltsMultiplier(recordedGain) + ((int32_t)1 << (shift - 1))) >> shift;
+
+    channels[sample.device * ADS_MUX_COUNT + Ads1115Plus::muxIndex(sample.mux)].points.push_back(point);
+    sampleCount++;
+    sorted = false;
+}
+
+void AdsTraceReplay::addSample(const AdsSample &sample) {
+    addSample(sample, sample.gain);
+}
+
+bool AdsTraceReplay::loadCsv(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        unsigned long timestamp;
+        unsigned int device, mux, gain;
+        int raw;
+        if (line[0] == '#' || sscanf(line, "%lu,%u,%u,%u,%d", &timestamp, &device, &mux, &gain, &raw) != 5) {
+            continue;
+        }
+        if (device >= 4 || mux >= ADS_MUX_COUNT || gain >= ADS_GAIN_COUNT || raw < -32768 || raw > 32767) {
+            continue;
+        }
+
+        AdsSample sample;
+        sample.timestampMicros = (uint32_t)timestamp;
+        sample.device = device;
+        sample.mux = (MuxConfig)(mux << 12);
+        sample.gain = (AdsGain)(gain << 9);
+        sample.raw = raw;
+        addSample(sample);
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool AdsTraceReplay::loadRecords(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    AdsRecordDecoder decoder;
+    AdsSample sample;
+    int value;
+    while ((value = fgetc(file)) != EOF) {
+        // Skip the samples with an unreliable timestamp
+        if (decoder.feed((uint8_t)value, sample) && decoder.isTimeSynced()) {
+            addSample(sample);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+size_t AdsTraceReplay::getSampleCount() {
+    return sampleCount;
+}
+
+uint32_t AdsTraceReplay::getDurationMicros() {
+    prepare();
+    return durationMicros;
+}
+
+void AdsTraceReplay::setSpeed(double speed) {
+    this->speed = speed > 0 ? speed : 1;
+}
+
+void AdsTraceReplay::setLooping(bool looping) {
+    this->looping = looping;
+}
+
+void AdsTraceReplay::setInterpolation(bool interpolating) {
+    this->interpolating = interpolating;
+}
+
+void AdsTraceReplay::start() {
+    prepare();
+    for (byte i = 0; i < 4 * ADS_MUX_COUNT; i++) {
+        channels[i].cursor = 0;
+    }
+    lastInputMicros = micros();
+    elapsedMicros = 0;
+    lastTraceMicros = 0;
+    started = true;
+}
+
+bool AdsTraceReplay::isFinished() {
+    return started && !looping && lastTraceMicros > durationMicros;
+}
+
+int32_t AdsTraceReplay::inputMicrovolts(byte device, MuxConfig mux, uint32_t timeMicros) {
+    if (!started) {
+        start();
+        lastInputMicros = timeMicros;
+    }
+
+    // The time advances by the (wrapping) difference with the last conversion, conversions started before start() or
+    // out of order read the time already reached
+    int32_t delta = (int32_t)(timeMicros - lastInputMicros);
+    if (delta > 0) {
+        elapsedMicros += (uint32_t)delta;
+        lastInputMicros = timeMicros;
+    }
+
+    if (device >= 4) {
+        return 0;
+    }
+    Channel &channel = channels[device * ADS_MUX_COUNT + Ads1115Plus::muxIndex(mux)];
+    if (channel.points.empty()) {
+        return 0;
+    }
+
+    uint64_t traceMicros = (uint64_t)(elapsedMicros * speed);
+    lastTraceMicros = traceMicros;
+    if (looping && durationMicros > 0) {
+        traceMicros %= (uint64_t)durationMicros + 1;
+    }
+
+    // Move the cursor to the last value at or before the trace time (backwards only when looping or out of order)
+    const std::vector<Point> &points = channel.points;
+    size_t cursor = channel.cursor < points.size() ? channel.cursor : 0;
+    if (points[cursor].timeMicros > traceMicros) {
+        cursor = 0;
+    }
+    while (cursor + 1 < points.size() && points[cursor + 1].timeMicros <= traceMicros) {
+        cursor++;
+    }
+    channel.cursor = cursor;
+
+    const Point &point = points[cursor];
+    if (!interpolating || cursor + 1 >= points.size() || point.timeMicros > traceMicros) {
+        return point.microvolts;
+    }
+    const Point &next = points[cursor + 1];
+    int64_t span = next.timeMicros - point.timeMicros;
+    int64_t offset = traceMicros - point.timeMicros;
+    return point.microvolts + (int32_t)(((int64_t)next.microvolts - point.microvolts) * offset / span);
+}
+
+// MARK: Private methods
+
+void AdsTraceReplay::prepare() {
+    if (sorted) {
+        return;
+    }
+
+    durationMicros = 0;
+    for (byte i = 0; i < 4 * ADS_MUX_COUNT; i++) {
+        std::vector<Point> &points = channels[i].points;
+        std::stable_sort(points.begin(), points.end(), [](const Point &a, const Point &b) { return a.timeMicros < b.timeMicros; });
+        if (!points.empty() && points.back().timeMicros > durationMicros) {
+            durationMicros = points.back().timeMicros;
+        }
+        channels[i].cursor = 0;
+    }
+    sorted = true;
+}
+
+#endif
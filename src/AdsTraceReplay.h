@@ -0,0 +1,140 @@
+#ifndef __ADS_TRACE_REPLAY_H__
+#define __ADS_TRACE_REPLAY_H__
+
+#include "Ads1115Plus.h"
+#include "AdsSimulator.h"
+
+#if defined(ADS1115PLUS_LINUX_I2C)
+
+#include <vector>
+
+/**
+ * Feeds a recorded trace to an AdsSimulator (see AdsSimulator::setSignalSource), so the whole read path runs against
+ * production-like signals, repeatably
+ *
+ * The trace holds, per device and mux, raw values with their timestamp and gain. It is loaded from:
+ * - A CSV file: one sample per line as "timestampMicros,device,mux index,gain index,raw" (lines starting with # are skipped)
+ * - A binary file written with AdsRecordEncoder (e.g. the BinaryLogging example), samples with a wrong CRC are dropped
+ *
+ * The trace starts with the first conversion after start() and plays at [speed] times real time. The inputs hold the
+ * last recorded value (or are interpolated between the recorded values), so a conversion with the recorded gain
+ * returns the recorded raw value.
+ */
+class AdsTraceReplay : public AdsSignalSource {
+
+private:
+
+    /** A recorded value */
+    struct Point {
+
+        /// The time since the first sample of the trace
+        uint32_t timeMicros;
+
+        /// The recorded input
+        int32_t microvolts;
+    };
+
+    /** The recorded values of a device and mux, in time order */
+    struct Channel {
+
+        /// The values
+        std::vector<Point> points;
+
+        /// The index of the last value served (the lookups are mostly in time order)
+        size_t cursor;
+    };
+
+    /// The channels indexed by device * ADS_MUX_COUNT + mux index
+    Channel channels[4 * ADS_MUX_COUNT];
+
+    /// The timestamp of the first sample of the trace
+    uint32_t firstTimestamp;
+
+    /// The time between the first and the last sample of the trace
+    uint32_t durationMicros;
+
+    /// The number of samples loaded
+    size_t sampleCount;
+
+    /// Whether the samples were sorted since the last addSample()
+    bool sorted;
+
+    /// The replay rate (1 is real time)
+    double speed;
+
+    /// Whether the trace starts over once finished
+    bool looping;
+
+    /// Whether the inputs are interpolated between the recorded values
+    bool interpolating;
+
+    /// Whether start() has been called (or the first conversion started the replay)
+    bool started;
+
+    /// The simulated micros() of the last conversion, [elapsedMicros] advances from it
+    uint32_t lastInputMicros;
+
+    /// The simulated time since start(), in 64 bits so long replays don't overflow when the 32 bits micros() wraps
+    uint64_t elapsedMicros;
+
+    /// The trace time of the last conversion
+    uint64_t lastTraceMicros;
+
+    /// Sorts the channels and computes the duration
+    void prepare();
+
+public:
+
+    /// Creates an empty trace (real time, not looping, holding the values)
+    AdsTraceReplay();
+
+    /// Removes every sample
+    void clear();
+
+    /// Adds a recorded [sample], the samples can be added in any order
+    void addSample(const AdsSample &sample, AdsGain recordedGain);
+
+    /// Adds a recorded [sample] (with the gain it carries)
+    void addSample(const AdsSample &sample);
+
+    /**
+     * Adds the samples of the given CSV file
+     * @return false if the file couldn't be read (the lines that can't be parsed are skipped)
+     */
+    bool loadCsv(const char *path);
+
+    /**
+     * Adds the samples of the given file of AdsRecordEncoder frames
+     * The samples decoded while the time isn't synced (after a dropped frame, until the next time frame) are skipped
+     * @return false if the file couldn't be read
+     */
+    bool loadRecords(const char *path);
+
+    /// Returns the number of samples loaded
+    size_t getSampleCount();
+
+    /// Returns the time between the first and the last sample of the trace
+    uint32_t getDurationMicros();
+
+    /// Sets the replay rate (2 plays the trace twice as fast as it was recorded)
+    void setSpeed(double speed);
+
+    /// Starts the trace over once it is finished (otherwise the last values are held)
+    void setLooping(bool looping);
+
+    /// Interpolates the inputs between the recorded values (otherwise the last recorded value is held)
+    void setInterpolation(bool interpolating);
+
+    /// Starts (or restarts) the trace now
+    void start();
+
+    /// Returns true once the conversions have gone past the end of the trace (never when looping)
+    bool isFinished();
+
+    /// Returns the recorded input at the given simulated time (called by the simulator)
+    int32_t inputMicrovolts(byte device, MuxConfig mux, uint32_t timeMicros) override;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,215 @@
+// Copyright(C) 2021 by Diego Eguez
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the "Software"), 
+// to deal in the Software without restriction, including without l > imitation the rights to use, copy, modify, merge, publish, distribute, 
+// sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+
+
+#include "AdsTriggerCapture.h"
+
+
+AdsTriggerCapture::AdsTriggerCapture(Ads1115Plus &ads, int16_t *buffer, uint16_t capacity) : ads(ads) {
+    this->buffer = buffer;
+    this->capacity = capacity;
+    preTriggerSamples = 0;
+    postTriggerSamples = 0;
+    windowLength = 0;
+    head = 0;
+    filled = 0;
+    remaining = 0;
+    triggerPosition = 0;
+    state = AdsCaptureState::idle;
+    triggerRequested = false;
+    dataReady = false;
+    readyPinPacing = false;
+    softwareTrigger = false;
+    triggerLevel = 0;
+    triggerEdge = AdsTriggerEdge::rising;
+    previousSample = 0;
+    hasPreviousSample = false;
+    periodMicros = 0;
+    nextReadMicros = 0;
+    triggerMicros = 0;
+    lastSampleMicros = 0;
+    mux = MuxConfig::channel0;
+    gain = AdsGain::twoThirds;
+}
+
+void AdsTriggerCapture::setSoftwareTrigger(int16_t level, AdsTriggerEdge edge) {
+    triggerLevel = level;
+    triggerEdge = edge;
+    softwareTrigger = true;
+}
+
+void AdsTriggerCapture::setSoftwareTriggerMicrovolts(int32_t levelMicrovolts, AdsTriggerEdge edge) {
+    setSoftwareTrigger(ads.microvoltsToRawValue(levelMicrovolts), edge);
+}
+
+void AdsTriggerCapture::disableSoftwareTrigger() {
+    softwareTrigger = false;
+}
+
+void AdsTriggerCapture::setReadyPinPacing(bool enabled) {
+    readyPinPacing = enabled;
+}
+
+bool AdsTriggerCapture::arm(uint16_t preTriggerSamples, uint16_t postTriggerSamples) {
+    if (postTriggerSamples == 0 || (uint32_t)preTriggerSamples + postTriggerSamples > capacity) {
+        return false;
+    }
+
+    state = AdsCaptureState::idle;
+    this->preTriggerSamples = preTriggerSamples;
+    this->postTriggerSamples = postTriggerSamples;
+    windowLength = preTriggerSamples + postTriggerSamples;
+    head = 0;
+    filled = 0;
+    remaining = postTriggerSamples;
+    triggerRequested = false;
+    dataReady = false;
+    hasPreviousSample = false;
+
+    mux = ads.getMux();
+    gain = ads.getGain();
+    periodMicros = Ads1115Plus::samplePeriodMicros(ads.getSampleSpeed());
+    nextReadMicros = micros();
+    state = AdsCaptureState::armed;
+    return true;
+}
+
+void AdsTriggerCapture::disarm() {
+    state = AdsCaptureState::idle;
+}
+
+void AdsTriggerCapture::trigger() {
+    triggerRequested = true;
+}
+
+void AdsTriggerCapture::conversionReady() {
+    dataReady = true;
+}
+
+bool AdsTriggerCapture::poll() {
+    if (state != AdsCaptureState::armed && state != AdsCaptureState::triggered) {
+        return false;
+    }
+
+    uint32_t now = micros();
+    if (readyPinPacing) {
+        if (!dataReady) {
+            return false;
+        }
+        dataReady = false;
+    } else {
+        // Signed difference, so the comparison survives the micros() overflow
+        if ((int32_t)(now - nextReadMicros) < 0) {
+            return false;
+        }
+        // Keep the grid, unless the reads fell behind by more than a period
+        nextReadMicros += periodMicros;
+        if ((int32_t)(now - nextReadMicros) >= 0) {
+            nextReadMicros = now + periodMicros;
+        }
+    }
+
+    store(ads.getLastConversionResults(), now);
+    return true;
+}
+
+AdsCaptureState AdsTriggerCapture::getState() {
+    return state;
+}
+
+bool AdsTriggerCapture::isComplete() {
+    return state == AdsCaptureState::complete;
+}
+
+uint16_t AdsTriggerCapture::getSampleCount() {
+    return state == AdsCaptureState::complete ? windowLength : 0;
+}
+
+uint16_t AdsTriggerCapture::getPreTriggerSamples() {
+    return preTriggerSamples;
+}
+
+int16_t AdsTriggerCapture::sample(uint16_t index) {
+    if (windowLength == 0) {
+        return 0;
+    }
+    // The window starts [preTriggerSamples] before the trigger
+    uint16_t position = (triggerPosition + windowLength - preTriggerSamples + index) % windowLength;
+    return buffer[position];
+}
+
+int32_t AdsTriggerCapture::sampleMicrovolts(uint16_t index) {
+    return ads.rawValueToMicrovolts(sample(index), mux, gain);
+}
+
+uint32_t AdsTriggerCapture::getTriggerMicros() {
+    return triggerMicros;
+}
+
+unsigned long AdsTriggerCapture::getSamplePeriodMicros() {
+    if (postTriggerSamples < 2) {
+        return periodMicros;
+    }
+    return (lastSampleMicros - triggerMicros) / (postTriggerSamples - 1);
+}
+
+// MARK: Private methods
+
+bool AdsTriggerCapture::crossesLevel(int16_t previous, int16_t current) {
+    bool rising = previous < triggerLevel && current >= triggerLevel;
+    bool falling = previous > triggerLevel && current <= triggerLevel;
+
+    switch (triggerEdge) {
+
+    case AdsTriggerEdge::rising:
+        return rising;
+
+    case AdsTriggerEdge::falling:
+        return falling;
+
+    default:
+        return rising || falling;
+    }
+}
+
+void AdsTriggerCapture::store(int16_t sample, uint32_t now) {
+    uint16_t position = head;
+    buffer[position] = sample;
+    head = head + 1 == windowLength ? 0 : head + 1;
+
+    if (state == AdsCaptureState::armed) {
+        // The software trigger needs a previous sample, the pre-trigger history has to be full
+        bool crossed = softwareTrigger && hasPreviousSample && crossesLevel(previousSample, sample);
+        previousSample = sample;
+        hasPreviousSample = true;
+        if (filled < preTriggerSamples) {
+            filled++;
+            triggerRequested = false;
+            return;
+        }
+        if (!crossed && !triggerRequested) {
+            return;
+        }
+
+        triggerRequested = false;
+        triggerPosition = position;
+        triggerMicros = now;
+        state = AdsCaptureState::triggered;
+    }
+
+    lastSampleMicros = now;
+    remaining--;
+    if (remaining == 0) {
+        state = AdsCaptureState::complete;
+    }
+}
@@ -0,0 +1,207 @@
+#ifndef __ADS_TRIGGER_CAPTURE_H__
+#define __ADS_TRIGGER_CAPTURE_H__
+
+#include "Ads1115Plus.h"
+
+/** The direction of the crossing that fires the software trigger */
+enum class AdsTriggerEdge {
+
+    /// The value goes from below the level to the level or above
+    rising,
+
+    /// The value goes from above the level to the level or below
+    falling,
+
+    /// Any crossing of the level
+    either
+};
+
+/** The progress of an AdsTriggerCapture */
+enum class AdsCaptureState {
+
+    /// Not armed, nothing is read
+    idle,
+
+    /// Filling the pre-trigger history, waiting for the trigger
+    armed,
+
+    /// Triggered, reading the post-trigger samples
+    triggered,
+
+    /// The window is frozen and can be read
+    complete
+};
+
+/**
+ * Oscilloscope style capture of the conversions around a trigger, from a device in continous conversion mode
+ *
+ * Once armed, every conversion goes into a circular history held in a buffer supplied by the caller (no heap).
+ * The trigger is either:
+ * - Hardware: call trigger() from the interrupt of the ALRT pin in comparator mode (it only sets a flag, O(1))
+ * - Software: the raw value crossing a level, checked on every conversion read
+ * Triggers are accepted once the pre-trigger history is full. The window then freezes after the post-trigger samples
+ * (the triggering conversion is the first of them) and stays unchanged until the next arm().
+ *
+ * The conversions are read by poll() every 1 / data rate, or each time conversionReady() is called from the interrupt
+ * of the ALRT pin in conversion ready mode (see Ads1115Plus::startConversionReadyModeOnMux), which reads every conversion
+ * exactly once. The ALRT pin carries either signal, so the conversion ready pacing goes with the software trigger.
+ */
+class AdsTriggerCapture {
+
+private:
+
+    /// The device read
+    Ads1115Plus &ads;
+
+    /// The samples, supplied by the caller
+    int16_t *buffer;
+
+    /// The size of [buffer] in samples
+    uint16_t capacity;
+
+    /// The number of samples kept before the trigger
+    uint16_t preTriggerSamples;
+
+    /// The number of samples kept from the trigger on
+    uint16_t postTriggerSamples;
+
+    /// The length of the circular history (pre + post)
+    uint16_t windowLength;
+
+    /// The position the next sample is written to
+    uint16_t head;
+
+    /// The number of samples written since arm() (saturates at [windowLength])
+    uint16_t filled;
+
+    /// The number of post-trigger samples still to read
+    uint16_t remaining;
+
+    /// The position of the triggering sample
+    uint16_t triggerPosition;
+
+    /// The progress of the capture
+    volatile AdsCaptureState state;
+
+    /// Set by trigger()
+    volatile bool triggerRequested;
+
+    /// Set by conversionReady()
+    volatile bool dataReady;
+
+    /// Whether the conversions are paced by conversionReady() rather than by time
+    bool readyPinPacing;
+
+    /// Whether the software trigger is enabled
+    bool softwareTrigger;
+
+    /// The level of the software trigger
+    int16_t triggerLevel;
+
+    /// The crossing direction of the software trigger
+    AdsTriggerEdge triggerEdge;
+
+    /// The sample read before the last one (for the software trigger)
+    int16_t previousSample;
+
+    /// Whether [previousSample] has been read since arm()
+    bool hasPreviousSample;
+
+    /// The time between two reads when paced by time
+    unsigned long periodMicros;
+
+    /// The scheduled time of the next read when paced by time
+    uint32_t nextReadMicros;
+
+    /// The time the triggering sample was read
+    uint32_t triggerMicros;
+
+    /// The time the last sample of the window was read
+    uint32_t lastSampleMicros;
+
+    /// The mux of the captured conversions
+    MuxConfig mux;
+
+    /// The gain of the captured conversions
+    AdsGain gain;
+
+    /// Returns true if the software trigger fires between [previous] and [current]
+    bool crossesLevel(int16_t previous, int16_t current);
+
+    /// Stores the [sample] read at [now] and handles the trigger
+    void store(int16_t sample, uint32_t now);
+
+public:
+
+    /**
+     * Creates a capture reading the given device into the given [buffer]
+     * @param capacity The size of the [buffer] in samples, bounds the pre + post trigger window
+     */
+    AdsTriggerCapture(Ads1115Plus &ads, int16_t *buffer, uint16_t capacity);
+
+    /**
+     * Sets the software trigger (disabled by default)
+     * @param level The raw level crossed
+     * @param edge The direction of the crossing
+     */
+    void setSoftwareTrigger(int16_t level, AdsTriggerEdge edge = AdsTriggerEdge::rising);
+
+    /// Sets the software trigger to a level in microvolts (converted with the gain and mux of the device when set)
+    void setSoftwareTriggerMicrovolts(int32_t levelMicrovolts, AdsTriggerEdge edge = AdsTriggerEdge::rising);
+
+    /// Disables the software trigger (only trigger() fires)
+    void disableSoftwareTrigger();
+
+    /**
+     * Paces the reads with conversionReady() instead of the nominal data rate
+     * @param enabled true when conversionReady() is called from the ALRT pin interrupt
+     */
+    void setReadyPinPacing(bool enabled);
+
+    /**
+     * Starts a capture (the previous window is discarded), the device has to be in continous conversion mode already
+     * @return false if [preTriggerSamples] + [postTriggerSamples] exceeds the capacity, or [postTriggerSamples] is 0
+     */
+    bool arm(uint16_t preTriggerSamples, uint16_t postTriggerSamples);
+
+    /// Stops the capture, the buffer is left as is
+    void disarm();
+
+    /// Requests the trigger (interrupt safe, O(1)), it fires on the next sample read once the pre-trigger history is full
+    void trigger();
+
+    /// Signals a finished conversion (interrupt safe, O(1)), used with setReadyPinPacing(true)
+    void conversionReady();
+
+    /**
+     * Reads the conversion when one is due and handles the trigger, call it as often as possible
+     * @return true if a sample was read
+     */
+    bool poll();
+
+    /// Returns the progress of the capture
+    AdsCaptureState getState();
+
+    /// Returns true when the window is frozen
+    bool isComplete();
+
+    /// Returns the number of samples in the frozen window (pre + post)
+    uint16_t getSampleCount();
+
+    /// Returns the number of samples before the triggering one
+    uint16_t getPreTriggerSamples();
+
+    /// Returns the raw sample at [index] of the frozen window, in chronological order (the trigger is at getPreTriggerSamples())
+    int16_t sample(uint16_t index);
+
+    /// Returns the sample at [index] of the frozen window in microvolts
+    int32_t sampleMicrovolts(uint16_t index);
+
+    /// Returns the micros() when the triggering sample was read
+    uint32_t getTriggerMicros();
+
+    /// Returns the time between two samples measured over the post-trigger samples (the nominal period if there is a single one)
+    unsigned long getSamplePeriodMicros();
+};
+
+#endif